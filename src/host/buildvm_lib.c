@@ -111,6 +111,10 @@ static int find_ffofs(BuildCtx *ctx, const char *name)
 
 static void libdef_func(BuildCtx *ctx, char *p, int arg)
 {
+  if (ffid > 255) {  /* GCfuncC.ffid is a uint8_t. */
+    fprintf(stderr, "Error: too many fast functions\n");
+    exit(1);
+  }
   if (arg != LIBINIT_CF)
     ffasmfunc++;
   if (ctx->mode == BUILD_libdef) {
@@ -30,6 +30,8 @@ Save LuaJIT bytecode: luajit -b[options] input output
   -l        Only list bytecode.
   -s        Strip debug info (default).
   -g        Keep debug info.
+  -L        Load inner functions lazily, on first use.
+  -B        Bundle many modules: luajit -b -B output [name=]input...
   -n name   Set module name (default: auto-detect from input name).
   -t type   Set output file type (default: auto-detect from output name).
   -a arch   Override architecture for object files (default: native).
@@ -618,14 +620,73 @@ end
 
 ------------------------------------------------------------------------------
 
+local function bundlemod(input)
+  local name, file = input:match("^([%w_.%-]+)=(.+)$")
+  if name then return name, file end
+  name = input:gsub("\\", "/"):gsub("^%./", ""):gsub("%.lua$", "")
+  name = name:gsub("/init$", ""):gsub("/", ".")
+  check(name:match("^[%w_.%-]+$"),
+	"cannot derive module name for ", input, ", use name=", input)
+  return name, input
+end
+
+-- FNV-1a hash of a module name. Must match bundle_hash() in lib_package.c.
+local function bundlehash(s)
+  local h = bit.tobit(0x811c9dc5)
+  for i=1,#s do
+    h = bit.bxor(h, string.byte(s, i))
+    h = bit.tobit(h * 403 + bit.lshift(h, 24))  -- h * 16777619
+  end
+  return h
+end
+
+local function u32le(x)
+  return string.char(bit.band(x, 255), bit.band(bit.rshift(x, 8), 255),
+		     bit.band(bit.rshift(x, 16), 255), bit.rshift(x, 24))
+end
+
+-- See the bundle format description in lib_package.c.
+local function bcbundle(ctx, inputs, mode)
+  local mods, seen = {}, {}
+  for _,input in ipairs(inputs) do
+    local name, file = bundlemod(input)
+    check(not seen[name], "duplicate module name ", name)
+    seen[name] = true
+    mods[#mods+1] = { name = name, s = string.dump(readfile(ctx, file), mode) }
+  end
+  local nslots = 1
+  while nslots < 2*#mods do nslots = nslots * 2 end
+  local slots, body = {}, {}
+  local ofs = 16 + 16*nslots
+  for _,m in ipairs(mods) do
+    local h = bundlehash(m.name)
+    local i = bit.band(h, nslots-1)
+    while slots[i] do i = bit.band(i+1, nslots-1) end
+    slots[i] = u32le(h)..u32le(ofs)..u32le(ofs + #m.name+1)..u32le(#m.s)
+    body[#body+1] = m.name.."\0"
+    body[#body+1] = m.s
+    ofs = ofs + #m.name+1 + #m.s
+  end
+  local t = { "\027LJB", u32le(1), u32le(ofs), u32le(nslots) }
+  local empty = string.rep("\0", 16)
+  for i=0,nslots-1 do t[#t+1] = slots[i] or empty end
+  return tconcat(t)..tconcat(body)
+end
+
 local function bclist(ctx, input, output)
   local f = readfile(ctx, input)
   require("jit.bc").dump(f, savefile(output, "w"), true)
 end
 
 local function bcsave(ctx, input, output)
-  local f = readfile(ctx, input)
-  local s = string.dump(f, ctx.strip)
+  local mode = (ctx.strip and "s" or "")..(ctx.lazy and "l" or "")
+  if mode == "" then mode = false end  -- An empty string would strip, too.
+  local s
+  if ctx.bundle then
+    s = bcbundle(ctx, input, mode)
+  else
+    s = string.dump(readfile(ctx, input), mode)
+  end
   local t = ctx.type
   if not t then
     t = detecttype(output)
@@ -634,7 +695,9 @@ local function bcsave(ctx, input, output)
   if t == "raw" then
     bcsave_raw(output, s)
   else
-    if not ctx.modname then ctx.modname = detectmodname(input) end
+    if not ctx.modname then
+      ctx.modname = detectmodname(ctx.bundle and output or input)
+    end
     if t == "obj" then
       bcsave_obj(ctx, output, s)
     else
@@ -649,7 +712,7 @@ local function docmd(...)
   local list = false
   local ctx = {
     strip = true, arch = jit.arch, os = jit.os:lower(),
-    type = false, modname = false,
+    type = false, modname = false, lazy = false, bundle = false,
   }
   while n <= #arg do
     local a = arg[n]
@@ -664,6 +727,10 @@ local function docmd(...)
 	  ctx.strip = true
 	elseif opt == "g" then
 	  ctx.strip = false
+	elseif opt == "L" then
+	  ctx.lazy = true
+	elseif opt == "B" then
+	  ctx.bundle = true
 	else
 	  if arg[n] == nil or m ~= #a then usage() end
 	  if opt == "e" then
@@ -691,6 +758,9 @@ local function docmd(...)
   if list then
     if #arg == 0 or #arg > 2 then usage() end
     bclist(ctx, arg[1], arg[2] or "-")
+  elseif ctx.bundle then
+    if #arg < 2 then usage() end
+    bcsave(ctx, { unpack(arg, 2) }, arg[1])
   else
     if #arg ~= 2 then usage() end
     bcsave(ctx, arg[1], arg[2])
@@ -30,6 +30,7 @@
 #include "lj_cconv.h"
 #endif
 #include "lj_bc.h"
+#include "lj_bcdump.h"
 #include "lj_ff.h"
 #include "lj_dispatch.h"
 #include "lj_char.h"
@@ -134,6 +135,8 @@ LJLIB_ASM(setmetatable)		LJLIB_REC(.)
   GCtab *mt = lj_lib_checktabornil(L, 2);
   if (!tvisnil(lj_meta_lookup(L, L->base, MM_metatable)))
     lj_err_caller(L, LJ_ERR_PROTMT);
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_caller(L, LJ_ERR_FROZEN);
   setgcref(t->metatable, obj2gco(mt));
   if (mt) { lj_gc_objbarriert(L, t, mt); }
   settabV(L, L->base-1-LJ_FR2, t);
@@ -220,7 +223,7 @@ LJLIB_CF(rawlen)		LJLIB_REC(.)
 }
 #endif
 
-LJLIB_CF(unpack)
+LJLIB_CF(unpack)		LJLIB_REC(.)
 {
   GCtab *t = lj_lib_checktab(L, 1);
   int32_t n, i = lj_lib_optint(L, 2, 1);
@@ -410,21 +413,19 @@ LJLIB_CF(load)
   int status;
   if (L->base < L->top &&
       (tvisstr(L->base) || tvisnumber(L->base) || tvisbuf(L->base))) {
-    const char *s;
-    MSize len;
     if (tvisbuf(L->base)) {
       SBufExt *sbx = bufV(L->base);
-      s = sbx->r;
-      len = sbufxlen(sbx);
       if (!name) name = &G(L)->strempty;  /* Buffers are not NUL-terminated. */
-    } else {
+      lua_settop(L, 4);  /* Ensure env arg exists. */
+      status = luaL_loadbufferx(L, sbx->r, sbufxlen(sbx), strdata(name),
+				mode ? strdata(mode) : NULL);
+    } else {  /* Strings are immutable, so inner functions may load lazily. */
       GCstr *str = lj_lib_checkstr(L, 1);
-      s = strdata(str);
-      len = str->len;
+      lua_settop(L, 4);  /* Ensure env arg exists. */
+      status = lj_load_owned(L, obj2gco(str), strdata(str), str->len,
+			     strdata(name ? name : str),
+			     mode ? strdata(mode) : NULL);
     }
-    lua_settop(L, 4);  /* Ensure env arg exists. */
-    status = luaL_loadbufferx(L, s, len, name ? strdata(name) : s,
-			      mode ? strdata(mode) : NULL);
   } else {
     lj_lib_checkfunc(L, 1);
     lua_settop(L, 5);  /* Reserve a slot for the string from the reader. */
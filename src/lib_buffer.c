@@ -28,8 +28,20 @@
 #endif
 #include "lj_strfmt.h"
 #include "lj_serialize.h"
+#include "lj_compress.h"
+#include "lj_json.h"
+#include "lj_chan.h"
 #include "lj_lib.h"
 
+#if LJ_TARGET_POSIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
 /* -- Helper functions ---------------------------------------------------- */
 
 /* Check that the first argument is a string buffer. */
@@ -256,6 +268,186 @@ LJLIB_CF(buffer_method_decode)		LJLIB_REC(.)
   return 1;
 }
 
+LJLIB_CF(buffer_method_putjson)		LJLIB_REC(.)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  cTValue *o = lj_lib_checkany(L, 2);
+  lj_json_put(sbx, o);
+  lj_gc_check(L);
+  L->top = L->base+1;  /* Chain buffer object. */
+  return 1;
+}
+
+LJLIB_CF(buffer_method_getjson)		LJLIB_REC(.)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  setnilV(L->top++);
+  sbx->r = lj_json_get(sbx, L->top-1);
+  lj_gc_check(L);
+  return 1;
+}
+
+LJLIB_CF(buffer_method_trydecode)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  if (lj_serialize_complete(sbx)) {
+    setboolV(L->top++, 1);
+    setnilV(L->top++);
+    sbx->r = lj_serialize_get(sbx, L->top-1);
+    lj_gc_check(L);
+    return 2;
+  }
+  setboolV(L->top++, 0);
+  return 1;
+}
+
+LJLIB_CF(buffer_method_encodeframe)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  cTValue *o = lj_lib_checkany(L, 2);
+  lj_serialize_putframe(sbx, o);
+  lj_gc_check(L);
+  L->top = L->base+1;  /* Chain buffer object. */
+  return 1;
+}
+
+LJLIB_CF(buffer_method_decodeframe)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  char *r;
+  setboolV(L->top++, 1);
+  setnilV(L->top++);
+  r = lj_serialize_getframe(sbx, L->top-1);
+  if (!r) {
+    L->top--;
+    setboolV(L->top-1, 0);
+    return 1;
+  }
+  sbx->r = r;
+  lj_gc_check(L);
+  return 2;
+}
+
+/* Get the optional source argument of compress/decompress. */
+static SBufExt *buffer_tosrc(lua_State *L, SBufExt *sbx, GCstr **strp)
+{
+  TValue *o = L->base+1;
+  if (o < L->top && !tvisnil(o)) {
+    if (tvisbuf(o)) {
+      SBufExt *sbx2 = bufV(o);
+      return sbx2 == sbx ? NULL : sbx2;
+    }
+    *strp = lj_lib_checkstr(L, 2);
+  }
+  return NULL;
+}
+
+LJLIB_CF(buffer_method_compress)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  GCstr *str = NULL;
+  SBufExt *src = buffer_tosrc(L, sbx, &str);
+  if (src) {
+    lj_compress_put(sbx, src->r, sbufxlen(src));
+    src->r = src->w;
+  } else if (str) {
+    lj_compress_put(sbx, strdata(str), str->len);
+  } else {
+    lj_compress_buf(sbx);
+  }
+  L->top = L->base+1;  /* Chain buffer object. */
+  return 1;
+}
+
+LJLIB_CF(buffer_method_decompress)
+{
+  SBufExt *sbx = buffer_tobufw(L);
+  GCstr *str = NULL;
+  SBufExt *src = buffer_tosrc(L, sbx, &str);
+  if (src) {  /* Streaming: leave an incomplete block in the source. */
+    src->r += lj_compress_get(sbx, src->r, sbufxlen(src));
+  } else if (str) {
+    if (lj_compress_get(sbx, strdata(str), str->len) != str->len)
+      lj_err_caller(L, LJ_ERR_BUFFER_EOB);
+  } else {
+    lj_decompress_buf(sbx);
+  }
+  L->top = L->base+1;  /* Chain buffer object. */
+  return 1;
+}
+
+#define BUFFER_READSZ	16384	/* Default size for buf:readfd(). */
+#define BUFFER_IOVMAX	64	/* Max. number of buffers for buf:writefd(). */
+
+LJLIB_CF(buffer_method_readfd)
+{
+#if LJ_TARGET_POSIX
+  SBufExt *sbx = buffer_tobufw(L);
+  int fd = lj_lib_checkint(L, 2);
+  MSize sz = (MSize)lj_lib_optint(L, 3, BUFFER_READSZ);
+  char *w;
+  ssize_t n;
+  if ((int32_t)sz <= 0) lj_err_arg(L, 3, LJ_ERR_NUMRNG);
+  w = lj_buf_more((SBuf *)sbx, sz);
+  do {
+    n = read(fd, w, sz);
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) return luaL_fileresult(L, 0, NULL);
+  sbx->w = w + n;
+  setintV(L->top++, (int32_t)n);
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("readfd") " not supported");
+#endif
+}
+
+LJLIB_CF(buffer_method_writefd)
+{
+#if LJ_TARGET_POSIX
+  SBufExt *sbx = buffer_tobuf(L), *bufs[BUFFER_IOVMAX];
+  struct iovec iov[BUFFER_IOVMAX];
+  int fd = lj_lib_checkint(L, 2);
+  ptrdiff_t arg, narg = L->top - L->base;
+  int i, niov = 1;
+  ssize_t n;
+  bufs[0] = sbx;
+  for (arg = 2; arg < narg; arg++) {
+    SBufExt *sbx2;
+    if (!tvisbuf(&L->base[arg])) lj_err_argtype(L, (int)(arg+1), "buffer");
+    if (niov >= BUFFER_IOVMAX)
+      lj_err_arg(L, (int)(arg+1), LJ_ERR_BUFFER_IOVMAX);
+    sbx2 = bufV(&L->base[arg]);
+    for (i = 0; i < niov; i++)
+      if (bufs[i] == sbx2) lj_err_arg(L, (int)(arg+1), LJ_ERR_BUFFER_DUPBUF);
+    bufs[niov++] = sbx2;
+  }
+  for (i = 0; i < niov; i++) {
+    iov[i].iov_base = bufs[i]->r;
+    iov[i].iov_len = sbufxlen(bufs[i]);
+  }
+  do {
+    n = niov == 1 ? write(fd, iov[0].iov_base, iov[0].iov_len) :
+		    writev(fd, iov, niov);
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) return luaL_fileresult(L, 0, NULL);
+  setintV(L->top++, (int32_t)n);
+  /* Consume the written data. */
+  for (i = 0; i < niov && n > 0; i++) {
+    SBufExt *sbx2 = bufs[i];
+    MSize len = sbufxlen(sbx2);
+    if ((size_t)n < len) {
+      sbx2->r += n;
+      break;
+    }
+    n -= len;
+    if (sbufiscow(sbx2)) sbx2->r = sbx2->w; else sbx2->r = sbx2->w = sbx2->b;
+  }
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("writefd") " not supported");
+#endif
+}
+
 LJLIB_CF(buffer_method___gc)
 {
   SBufExt *sbx = buffer_tobuf(L);
@@ -281,18 +473,140 @@ LJLIB_CF(buffer_method___len)		LJLIB_REC(.)
 LJLIB_PUSH("buffer") LJLIB_SET(__metatable)
 LJLIB_PUSH(top-1) LJLIB_SET(__index)
 
+/* -- Channel methods ----------------------------------------------------- */
+
+#define LJLIB_MODULE_buffer_chan
+
+#if LJ_TARGET_POSIX
+/* Check that the first argument is a channel. */
+static LJChan *buffer_tochan(lua_State *L)
+{
+  if (!(L->base < L->top && tvisudata(L->base) &&
+	udataV(L->base)->udtype == UDTYPE_CHANNEL))
+    lj_err_argtype(L, 1, "channel");
+  return *(LJChan **)uddata(udataV(L->base));
+}
+
+/* Optional timeout in seconds. Negative or nil waits forever. */
+static double buffer_opttimeout(lua_State *L, int narg, double def)
+{
+  TValue *o = L->base + narg-1;
+  if (o < L->top && !tvisnil(o)) return lj_lib_checknum(L, narg);
+  return def;
+}
+#endif
+
+LJLIB_CF(buffer_chan_send)
+{
+#if LJ_TARGET_POSIX
+  LJChan *ch = buffer_tochan(L);
+  cTValue *o = lj_lib_checkany(L, 2);
+  setboolV(L->top++, lj_chan_send(L, ch, o));
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
+LJLIB_CF(buffer_chan_recv)
+{
+#if LJ_TARGET_POSIX
+  LJChan *ch = buffer_tochan(L);
+  double t = buffer_opttimeout(L, 2, -1);
+  setnilV(L->top++);
+  if (!lj_chan_recv(L, ch, L->top-1, t)) return 0;
+  lj_gc_check(L);
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
+LJLIB_CF(buffer_chan_tryrecv)
+{
+#if LJ_TARGET_POSIX
+  LJChan *ch = buffer_tochan(L);
+  double t = buffer_opttimeout(L, 2, 0);
+  setboolV(L->top++, 1);
+  setnilV(L->top++);
+  if (!lj_chan_recv(L, ch, L->top-1, t)) {
+    L->top--;
+    setboolV(L->top-1, 0);
+    return 1;
+  }
+  lj_gc_check(L);
+  return 2;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
+LJLIB_CF(buffer_chan_handle)
+{
+#if LJ_TARGET_POSIX
+  void *p = (void *)(uintptr_t)lj_chan_id(buffer_tochan(L));
+#if LJ_64
+  p = lj_lightud_intern(L, p);
+#endif
+  setrawlightudV(L->top++, p);
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
+LJLIB_CF(buffer_chan___gc)
+{
+#if LJ_TARGET_POSIX
+  LJChan *ch = buffer_tochan(L);
+  if (ch) {
+    *(LJChan **)uddata(udataV(L->base)) = NULL;
+    lj_chan_unref(ch);
+  }
+#endif
+  return 0;
+}
+
+LJLIB_CF(buffer_chan___len)
+{
+#if LJ_TARGET_POSIX
+  setintV(L->top-1, (int32_t)lj_chan_count(buffer_tochan(L)));
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
+LJLIB_PUSH("channel") LJLIB_SET(__metatable)
+LJLIB_PUSH(top-1) LJLIB_SET(__index)
+
 /* -- Buffer library functions -------------------------------------------- */
 
 #define LJLIB_MODULE_buffer
 
 LJLIB_PUSH(top-2) LJLIB_SET(!)  /* Set environment. */
 
+/* Create a new buffer object on the stack. */
+static SBufExt *buffer_alloc(lua_State *L)
+{
+  GCtab *env = tabref(curr_func(L)->c.env);
+  GCudata *ud = lj_udata_new(L, sizeof(SBufExt), env);
+  SBufExt *sbx;
+  ud->udtype = UDTYPE_BUFFER;
+  /* NOBARRIER: The GCudata is new (marked white). */
+  setgcref(ud->metatable, obj2gco(env));
+  setudataV(L, L->top++, ud);
+  sbx = (SBufExt *)uddata(ud);
+  lj_bufx_init(L, sbx);
+  return sbx;
+}
+
 LJLIB_CF(buffer_new)
 {
   MSize sz = 0;
   int targ = 1;
-  GCtab *env, *dict_str = NULL, *dict_mt = NULL;
-  GCudata *ud;
+  GCtab *dict_str = NULL, *dict_mt = NULL;
+  uint32_t sopt = 0, adictsz = 0;
   SBufExt *sbx;
   if (L->base < L->top && !tvistab(L->base)) {
     targ = 2;
@@ -301,7 +615,7 @@ LJLIB_CF(buffer_new)
   }
   if (L->base+targ-1 < L->top) {
     GCtab *options = lj_lib_checktab(L, targ);
-    cTValue *opt_dict, *opt_mt;
+    cTValue *opt_dict, *opt_mt, *opt_shapes, *opt_refs, *opt_adapt;
     opt_dict = lj_tab_getstr(options, lj_str_newlit(L, "dict"));
     if (opt_dict && tvistab(opt_dict)) {
       dict_str = tabV(opt_dict);
@@ -312,22 +626,81 @@ LJLIB_CF(buffer_new)
       dict_mt = tabV(opt_mt);
       lj_serialize_dict_prep_mt(L, dict_mt);
     }
+    opt_shapes = lj_tab_getstr(options, lj_str_newlit(L, "shapes"));
+    if (opt_shapes && tvistruecond(opt_shapes))
+      sopt |= LJ_SERIALIZE_SHAPE;
+    opt_refs = lj_tab_getstr(options, lj_str_newlit(L, "refs"));
+    if (opt_refs && tvistruecond(opt_refs))
+      sopt |= LJ_SERIALIZE_REF;
+    opt_adapt = lj_tab_getstr(options, lj_str_newlit(L, "adaptive"));
+    if (opt_adapt && tvisnumber(opt_adapt)) {
+      int32_t n = numberVint(opt_adapt);
+      if (n < 1 || n > LJ_SERIALIZE_ADICTMAX)
+	lj_err_caller(L, LJ_ERR_BUFFER_BADOPT);
+      adictsz = (uint32_t)n;
+    } else if (opt_adapt && tvistruecond(opt_adapt)) {
+      adictsz = LJ_SERIALIZE_ADICTSZ;
+    }
   }
-  env = tabref(curr_func(L)->c.env);
-  ud = lj_udata_new(L, sizeof(SBufExt), env);
-  ud->udtype = UDTYPE_BUFFER;
-  /* NOBARRIER: The GCudata is new (marked white). */
-  setgcref(ud->metatable, obj2gco(env));
-  setudataV(L, L->top++, ud);
-  sbx = (SBufExt *)uddata(ud);
-  lj_bufx_init(L, sbx);
+  sbx = buffer_alloc(L);
   setgcref(sbx->dict_str, obj2gco(dict_str));
   setgcref(sbx->dict_mt, obj2gco(dict_mt));
+  sbx->sopt = sopt;
+  if (adictsz) lj_serialize_adict_init(L, sbx, adictsz);
   if (sz > 0) lj_buf_need2((SBuf *)sbx, sz);
   lj_gc_check(L);
   return 1;
 }
 
+LJLIB_CF(buffer_map)
+{
+#if LJ_TARGET_POSIX
+  const char *path = strdata(lj_lib_checkstr(L, 1));
+  off_t ofs = 0, len = -1, base;
+  SBufExt *sbx;
+  struct stat st;
+  int fd;
+  if (L->base+1 < L->top && !tvisnil(L->base+1)) {
+    lua_Number n = lj_lib_checknum(L, 2);
+    if (!(n >= 0 && n <= 9007199254740992.0)) lj_err_arg(L, 2, LJ_ERR_NUMRNG);
+    ofs = (off_t)n;
+  }
+  if (L->base+2 < L->top && !tvisnil(L->base+2))
+    len = (off_t)lj_lib_checkintrange(L, 3, 0, LJ_MAX_BUF);
+  sbx = buffer_alloc(L);
+  fd = open(path, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) != 0) goto fail;
+  if (ofs > st.st_size) ofs = st.st_size;
+  if (len < 0 || len > st.st_size - ofs) len = st.st_size - ofs;
+  if (len > LJ_MAX_BUF) {
+    close(fd);
+    lj_err_caller(L, LJ_ERR_BUFFER_MAPSZ);
+  }
+  if (len > 0) {
+    void *p;
+    base = ofs & ~(off_t)(sysconf(_SC_PAGESIZE)-1);
+    p = mmap(NULL, (size_t)(ofs - base + len), PROT_READ, MAP_PRIVATE,
+	     fd, base);
+    if (p == MAP_FAILED) goto fail;
+    lj_bufx_set_cow(L, sbx, (const char *)p, (MSize)(ofs - base + len));
+    sbx->r += ofs - base;
+    /* NOBARRIER: The GCudata is new (marked white). */
+    setgcref(sbx->cowref, obj2gco(buffer_toudata(sbx)));
+  }
+  close(fd);
+  return 1;
+fail:
+  if (fd >= 0) {
+    int err = errno;
+    close(fd);
+    errno = err;
+  }
+  return luaL_fileresult(L, 0, path);
+#else
+  return luaL_error(L, LUA_QL("map") " not supported");
+#endif
+}
+
 LJLIB_CF(buffer_encode)			LJLIB_REC(.)
 {
   cTValue *o = lj_lib_checkany(L, 1);
@@ -345,12 +718,73 @@ LJLIB_CF(buffer_decode)			LJLIB_REC(.)
   return 1;
 }
 
+/* Set limit of the buffer pool, if given, and return its statistics. */
+LJLIB_CF(buffer_pool)
+{
+  global_State *g = G(L);
+  SBufPool *bp = &g->bufpool;
+  GCtab *t;
+  uint32_t blocks = 0;
+  int c;
+  if (L->base < L->top && !tvisnil(L->base)) {
+    lua_Number n = lj_lib_checknum(L, 1);
+    if (!(n >= 0 && n <= (lua_Number)LJ_MAX_BUF))
+      lj_err_arg(L, 1, LJ_ERR_NUMRNG);
+    bp->limit = (GCSize)n;
+    if (bp->retained > bp->limit) lj_buf_pool_free(g);
+  }
+  for (c = 0; c < SBUFPOOL_NCLASS; c++) blocks += bp->num[c];
+  t = lj_tab_new(L, 0, 3);
+  settabV(L, L->top++, t);
+  setnumV(lj_tab_setstr(L, t, lj_str_newlit(L, "hits")), (lua_Number)bp->hits);
+  setnumV(lj_tab_setstr(L, t, lj_str_newlit(L, "misses")),
+	  (lua_Number)bp->misses);
+  setnumV(lj_tab_setstr(L, t, lj_str_newlit(L, "retained")),
+	  (lua_Number)bp->retained);
+  setnumV(lj_tab_setstr(L, t, lj_str_newlit(L, "limit")),
+	  (lua_Number)bp->limit);
+  setintV(lj_tab_setstr(L, t, lj_str_newlit(L, "blocks")), (int32_t)blocks);
+  lj_gc_check(L);
+  return 1;
+}
+
+LJLIB_PUSH(top-3) LJLIB_SET(!)  /* Channel methods as environment. */
+
+LJLIB_CF(buffer_channel)
+{
+#if LJ_TARGET_POSIX
+  GCtab *env = tabref(curr_func(L)->c.env);
+  GCudata *ud;
+  LJChan *ch;
+  if (L->base < L->top && tvislightud(L->base)) {
+    ch = lj_chan_lookup((uint64_t)(uintptr_t)lightudV(G(L), L->base));
+    if (!ch) lj_err_arg(L, 1, LJ_ERR_BUFFER_BADCHAN);
+  } else {
+    uint32_t n = (uint32_t)lj_lib_checkintrange(L, 1, 1, LJ_CHAN_MAXSLOTS);
+    uint32_t sz = (uint32_t)lj_lib_optint(L, 2, LJ_CHAN_SLOTSZ);
+    if (sz > LJ_CHAN_MAXSLOTSZ) lj_err_arg(L, 2, LJ_ERR_NUMRNG);
+    ch = lj_chan_new(n, sz);
+    if (!ch) lj_err_mem(L);
+  }
+  ud = lj_udata_new(L, sizeof(LJChan *), env);
+  ud->udtype = UDTYPE_CHANNEL;
+  /* NOBARRIER: The GCudata is new (marked white). */
+  setgcref(ud->metatable, obj2gco(env));
+  *(LJChan **)uddata(ud) = ch;
+  setudataV(L, L->top++, ud);
+  return 1;
+#else
+  return luaL_error(L, LUA_QL("channel") " not supported");
+#endif
+}
+
 /* ------------------------------------------------------------------------ */
 
 #include "lj_libdef.h"
 
 int luaopen_string_buffer(lua_State *L)
 {
+  LJ_LIB_REG(L, NULL, buffer_chan);
   LJ_LIB_REG(L, NULL, buffer_method);
   lua_getfield(L, -1, "__tostring");
   lua_setfield(L, -2, "tostring");
@@ -0,0 +1,798 @@
+/*
+** Event loop library.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+**
+** Coroutines created with spawn() wait for file descriptors and timers.
+** Each wait yields back to run(), which multiplexes all pending waits with
+** epoll and a single timerfd. Reads and writes on a descriptor are retried
+** by the loop itself when it becomes ready, so a coroutine is only resumed
+** once the operation is complete. A plain coroutine.yield() from an event
+** coroutine just lets the other coroutines run first.
+*/
+
+#define lib_event_c
+#define LUA_LIB
+
+#include "lua.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include "lj_obj.h"
+
+#if LJ_TARGET_LINUX
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+
+#include "lj_gc.h"
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_io.h"
+#include "lj_lib.h"
+
+/* -- Event loop state ---------------------------------------------------- */
+
+/* Slots of the environment table shared by all functions of the module. */
+enum {
+  EV_STATE = 1,	/* Userdata holding the EvState. */
+  EV_CO,	/* Set of coroutines started by spawn(). */
+  EV_RQ,	/* Ready queue: coroutine and up to two resume values. */
+  EV_RD,	/* Wait records for readable descriptors. */
+  EV_WR,	/* Wait records for writable descriptors. */
+  EV_TM,	/* Wait records with a timeout, keyed by sequence number. */
+  EV_MASK,	/* Event mask registered with epoll for each descriptor. */
+  EV__MAX
+};
+
+/* Slots of a wait record. */
+enum {
+  REC_CO = 1,	/* Waiting coroutine or nil after wakeup. */
+  REC_FD,	/* Descriptor or nil. */
+  REC_DIR,	/* EV_DIR_READ or EV_DIR_WRITE. */
+  REC_SEQ,	/* Timer sequence number or nil. */
+  REC_OP,	/* Operation to complete once the descriptor is ready. */
+  REC_DATA,	/* String to write or max. number of bytes to read. */
+  REC_OFS	/* Number of bytes written so far. */
+};
+
+#define EV_DIR_READ	1
+#define EV_DIR_WRITE	2
+
+#define EV_OP_WAIT	0
+#define EV_OP_READ	1
+#define EV_OP_WRITE	2
+
+#define EV_READMAX	65536	/* Default max. size of a read. */
+#define EV_MAXEVENTS	256	/* Max. events per epoll_wait() call. */
+
+typedef struct EvTimer {
+  double t;		/* Deadline. */
+  int32_t seq;		/* Key of the wait record in EV_TM. */
+} EvTimer;
+
+typedef struct EvState {
+  int epfd;		/* epoll descriptor or -1. */
+  int tfd;		/* timerfd descriptor or -1. */
+  int running;		/* run() is active. */
+  int waiting;		/* Set by a coroutine that yields to wait. */
+  int32_t nwait;	/* Number of waiting coroutines. */
+  int32_t seq;		/* Last timer sequence number. */
+  int32_t rqhead, rqtail;  /* Ready queue positions. */
+  MSize ntimer, sztimer;  /* Size and capacity of the timer heap. */
+  EvTimer *timer;	/* Min-heap of timer deadlines. */
+} EvState;
+
+static double ev_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int ev_gc(lua_State *L)
+{
+  EvState *st = (EvState *)lua_touserdata(L, 1);
+  if (st->epfd >= 0) close(st->epfd);
+  if (st->tfd >= 0) close(st->tfd);
+  st->epfd = st->tfd = -1;
+  lj_mem_freevec(G(L), st->timer, st->sztimer, EvTimer);
+  st->timer = NULL;
+  st->ntimer = st->sztimer = 0;
+  return 0;
+}
+
+/* Get the loop state. The descriptors are created on first use. */
+static EvState *ev_state(lua_State *L)
+{
+  EvState *st;
+  lua_rawgeti(L, LUA_ENVIRONINDEX, EV_STATE);
+  st = (EvState *)lua_touserdata(L, -1);
+  lua_pop(L, 1);
+  if (st->epfd < 0) {
+    struct epoll_event ev;
+    st->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (st->epfd < 0) luaL_error(L, "epoll_create1: %s", strerror(errno));
+    st->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK|TFD_CLOEXEC);
+    if (st->tfd < 0) luaL_error(L, "timerfd_create: %s", strerror(errno));
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = st->tfd;
+    if (epoll_ctl(st->epfd, EPOLL_CTL_ADD, st->tfd, &ev) != 0)
+      luaL_error(L, "epoll_ctl: %s", strerror(errno));
+  }
+  return st;
+}
+
+static void ev_tab(lua_State *L, int slot)
+{
+  lua_rawgeti(L, LUA_ENVIRONINDEX, slot);
+}
+
+/* Get a descriptor from a number or an I/O file. */
+static int ev_checkfd(lua_State *L, int narg)
+{
+  TValue *o = L->base + narg-1;
+  if (o < L->top && tvisudata(o) && udataV(o)->udtype == UDTYPE_IO_FILE) {
+    IOFileUD *iof = (IOFileUD *)uddata(udataV(o));
+    if (iof->fp == NULL)
+      lj_err_caller(L, LJ_ERR_IOCLFL);
+    return fileno(iof->fp);
+  } else {
+    int32_t fd = lj_lib_checkint(L, narg);
+    if (fd < 0) lj_err_arg(L, narg, LJ_ERR_BADVAL);
+    return fd;
+  }
+}
+
+/* Get an optional timeout. Returns a negative number if there's none. */
+static double ev_opttime(lua_State *L, int narg)
+{
+  TValue *o = L->base + narg-1;
+  if (o >= L->top || tvisnil(o)) return -1.0;
+  else {
+    double t = lj_lib_checknum(L, narg);
+    return t < 0.0 ? 0.0 : t;
+  }
+}
+
+static int ev_errresult(lua_State *L, int err)
+{
+  lua_pushnil(L);
+  lua_pushstring(L, strerror(err));
+  lua_pushinteger(L, err);
+  return 3;
+}
+
+/* -- Timer heap ---------------------------------------------------------- */
+
+static void ev_timer_push(lua_State *L, EvState *st, double t, int32_t seq)
+{
+  MSize i;
+  if (st->ntimer >= st->sztimer)
+    lj_mem_growvec(L, st->timer, st->sztimer, LJ_MAX_MEM32, EvTimer);
+  for (i = st->ntimer++; i > 0; ) {
+    MSize p = (i-1) >> 1;
+    if (st->timer[p].t <= t) break;
+    st->timer[i] = st->timer[p];
+    i = p;
+  }
+  st->timer[i].t = t;
+  st->timer[i].seq = seq;
+}
+
+static void ev_timer_pop(EvState *st)
+{
+  MSize i = 0, n = --st->ntimer;
+  EvTimer last = st->timer[n];
+  for (;;) {
+    MSize c = 2*i+1;
+    if (c >= n) break;
+    if (c+1 < n && st->timer[c+1].t < st->timer[c].t) c++;
+    if (last.t <= st->timer[c].t) break;
+    st->timer[i] = st->timer[c];
+    i = c;
+  }
+  st->timer[i] = last;
+}
+
+/* Check whether a timer still belongs to a pending wait. */
+static int ev_timer_live(lua_State *L, int32_t seq)
+{
+  int live;
+  ev_tab(L, EV_TM);
+  lua_rawgeti(L, -1, seq);
+  live = !lua_isnil(L, -1);
+  lua_pop(L, 2);
+  return live;
+}
+
+/* Arm the timerfd for the earliest pending deadline. */
+static void ev_timer_arm(lua_State *L, EvState *st)
+{
+  struct itimerspec its;
+  memset(&its, 0, sizeof(its));
+  while (st->ntimer && !ev_timer_live(L, st->timer[0].seq))
+    ev_timer_pop(st);  /* Drop timers of waits that already ended. */
+  if (st->ntimer) {
+    double t = st->timer[0].t;
+    its.it_value.tv_sec = (time_t)t;
+    its.it_value.tv_nsec = (long)((t - (double)its.it_value.tv_sec) * 1e9);
+    if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0)
+      its.it_value.tv_nsec = 1;  /* Zero would disarm the timer. */
+  }
+  timerfd_settime(st->tfd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+/* -- Wait records -------------------------------------------------------- */
+
+/* Queue a coroutine. Expects the coroutine and two values on the stack. */
+static void ev_ready(lua_State *L, EvState *st)
+{
+  int32_t base = st->rqtail++ * 3;
+  ev_tab(L, EV_RQ);
+  lua_insert(L, -4);
+  lua_rawseti(L, -4, base+3);
+  lua_rawseti(L, -3, base+2);
+  lua_rawseti(L, -2, base+1);
+  lua_pop(L, 1);
+}
+
+/* Update the epoll registration of a descriptor. Returns an errno or 0. */
+static int ev_ctl(lua_State *L, EvState *st, int fd)
+{
+  struct epoll_event ev;
+  int old, mask = 0, op, res;
+  ev_tab(L, EV_RD);
+  lua_rawgeti(L, -1, fd);
+  if (!lua_isnil(L, -1)) mask |= EPOLLIN;
+  ev_tab(L, EV_WR);
+  lua_rawgeti(L, -1, fd);
+  if (!lua_isnil(L, -1)) mask |= EPOLLOUT;
+  ev_tab(L, EV_MASK);
+  lua_rawgeti(L, -1, fd);
+  old = (int)lua_tointeger(L, -1);
+  lua_pop(L, 1);
+  if (mask == old) {
+    lua_pop(L, 5);
+    return 0;
+  }
+  memset(&ev, 0, sizeof(ev));
+  ev.events = (uint32_t)mask;
+  ev.data.fd = fd;
+  op = !old ? EPOLL_CTL_ADD : !mask ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+  res = epoll_ctl(st->epfd, op, fd, &ev);
+  if (res != 0 && op == EPOLL_CTL_MOD && errno == ENOENT)
+    res = epoll_ctl(st->epfd, EPOLL_CTL_ADD, fd, &ev);  /* fd was reused. */
+  if (res == 0 || op == EPOLL_CTL_DEL) {
+    if (mask) lua_pushinteger(L, mask); else lua_pushnil(L);
+    lua_rawseti(L, -2, fd);
+    res = 0;
+  } else {
+    res = errno;
+  }
+  lua_pop(L, 5);
+  return res;
+}
+
+/* End a wait and queue the coroutine with the nres (1 or 2) values on top. */
+static void ev_wake(lua_State *L, EvState *st, int rec, int nres)
+{
+  lua_rawgeti(L, rec, REC_CO);
+  if (lua_isnil(L, -1)) {
+    lua_pop(L, nres+1);
+    return;
+  }
+  lua_insert(L, -1-nres);
+  if (nres == 1) lua_pushnil(L);
+  lua_pushnil(L);
+  lua_rawseti(L, rec, REC_CO);
+  lua_rawgeti(L, rec, REC_FD);
+  if (!lua_isnil(L, -1)) {
+    int fd = (int)lua_tointeger(L, -1);
+    lua_rawgeti(L, rec, REC_DIR);
+    ev_tab(L, lua_tointeger(L, -1) == EV_DIR_READ ? EV_RD : EV_WR);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, fd);
+    lua_pop(L, 2);
+    ev_ctl(L, st, fd);
+  }
+  lua_pop(L, 1);
+  lua_rawgeti(L, rec, REC_SEQ);
+  if (!lua_isnil(L, -1)) {
+    ev_tab(L, EV_TM);
+    lua_pushnil(L);
+    lua_rawseti(L, -2, (int)lua_tointeger(L, -3));
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 1);
+  st->nwait--;
+  ev_ready(L, st);
+}
+
+/* Try to complete the operation of a wait record for a ready descriptor. */
+static void ev_complete(lua_State *L, EvState *st, int rec)
+{
+  int fd, op;
+  lua_rawgeti(L, rec, REC_FD);
+  lua_rawgeti(L, rec, REC_OP);
+  fd = (int)lua_tointeger(L, -2);
+  op = (int)lua_tointeger(L, -1);
+  lua_pop(L, 2);
+  if (op == EV_OP_READ) {
+    MSize sz;
+    ssize_t n;
+    char *buf;
+    lua_rawgeti(L, rec, REC_DATA);
+    sz = (MSize)lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    buf = lj_buf_tmp(L, sz);
+    n = read(fd, buf, sz);
+    if (n > 0) {
+      lua_pushlstring(L, buf, (size_t)n);
+    } else if (n == 0) {
+      lua_pushnil(L);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      return;  /* Spurious wakeup. Keep waiting. */
+    } else {
+      lua_pushnil(L);
+      lua_pushstring(L, strerror(errno));
+      ev_wake(L, st, rec, 2);
+      return;
+    }
+  } else if (op == EV_OP_WRITE) {
+    size_t len, ofs;
+    const char *s;
+    ssize_t n;
+    lua_rawgeti(L, rec, REC_DATA);
+    lua_rawgeti(L, rec, REC_OFS);
+    s = lua_tolstring(L, -2, &len);
+    ofs = (size_t)lua_tointeger(L, -1);
+    n = write(fd, s + ofs, len - ofs);
+    lua_pop(L, 2);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+	return;
+      lua_pushnil(L);
+      lua_pushstring(L, strerror(errno));
+      ev_wake(L, st, rec, 2);
+      return;
+    }
+    ofs += (size_t)n;
+    if (ofs < len) {
+      lua_pushinteger(L, (lua_Integer)ofs);
+      lua_rawseti(L, rec, REC_OFS);
+      return;
+    }
+    lua_pushboolean(L, 1);
+  } else {
+    lua_pushboolean(L, 1);
+  }
+  ev_wake(L, st, rec, 1);
+}
+
+/* Create a wait record on the stack. */
+static void ev_newrec(lua_State *L, int fd, int dir, int op)
+{
+  lua_createtable(L, REC_OFS, 0);
+  if (fd >= 0) {
+    lua_pushinteger(L, fd);
+    lua_rawseti(L, -2, REC_FD);
+    lua_pushinteger(L, dir);
+    lua_rawseti(L, -2, REC_DIR);
+  }
+  lua_pushinteger(L, op);
+  lua_rawseti(L, -2, REC_OP);
+}
+
+static void ev_checkco(lua_State *L)
+{
+  int ok;
+  ev_tab(L, EV_CO);
+  lua_pushthread(L);
+  lua_rawget(L, -2);
+  ok = lua_toboolean(L, -1);
+  lua_pop(L, 2);
+  if (!ok)
+    lj_err_caller(L, LJ_ERR_IOEVCO);
+}
+
+/* Register the wait record on top of the stack and yield to the loop. */
+static int ev_wait(lua_State *L, EvState *st, double timeout)
+{
+  int rec = lua_gettop(L);
+  lua_pushthread(L);
+  lua_rawseti(L, rec, REC_CO);
+  lua_rawgeti(L, rec, REC_FD);
+  if (!lua_isnil(L, -1)) {
+    int fd = (int)lua_tointeger(L, -1), err;
+    lua_rawgeti(L, rec, REC_DIR);
+    ev_tab(L, lua_tointeger(L, -1) == EV_DIR_READ ? EV_RD : EV_WR);
+    lua_rawgeti(L, -1, fd);
+    if (!lua_isnil(L, -1))
+      lj_err_caller(L, LJ_ERR_IOEVBUSY);
+    lua_pop(L, 1);
+    lua_pushvalue(L, rec);
+    lua_rawseti(L, -2, fd);
+    err = ev_ctl(L, st, fd);
+    if (err) {
+      lua_pushnil(L);
+      lua_rawseti(L, -2, fd);
+      if (err != EPERM)
+	return ev_errresult(L, err);
+      /* Regular files can't be polled, but they are always ready. */
+      lua_pop(L, 3);
+      st->nwait++;
+      ev_complete(L, st, rec);
+      st->waiting = 1;
+      return lua_yield(L, 0);
+    }
+    lua_pop(L, 2);
+  }
+  lua_pop(L, 1);
+  if (timeout >= 0.0) {
+    int32_t seq = ++st->seq;
+    ev_tab(L, EV_TM);
+    lua_pushvalue(L, rec);
+    lua_rawseti(L, -2, seq);
+    lua_pop(L, 1);
+    lua_pushinteger(L, seq);
+    lua_rawseti(L, rec, REC_SEQ);
+    ev_timer_push(L, st, ev_now() + timeout, seq);
+  }
+  st->nwait++;
+  st->waiting = 1;
+  return lua_yield(L, 0);
+}
+
+/* Wait for events and complete the corresponding waits. */
+static void ev_poll(lua_State *L, EvState *st)
+{
+  struct epoll_event ev[EV_MAXEVENTS];
+  int i, n;
+  ev_timer_arm(L, st);
+  n = epoll_wait(st->epfd, ev, EV_MAXEVENTS, -1);
+  if (n < 0) {
+    if (errno == EINTR) return;
+    luaL_error(L, "epoll_wait: %s", strerror(errno));
+  }
+  for (i = 0; i < n; i++) {
+    int fd = ev[i].data.fd;
+    uint32_t e = ev[i].events;
+    if (fd == st->tfd) {
+      uint64_t x;
+      double now = ev_now();
+      if (read(st->tfd, &x, sizeof(x))) {}
+      while (st->ntimer && st->timer[0].t <= now) {
+	int32_t seq = st->timer[0].seq;
+	ev_timer_pop(st);
+	ev_tab(L, EV_TM);
+	lua_rawgeti(L, -1, seq);
+	if (lua_istable(L, -1)) {
+	  int rec = lua_gettop(L);
+	  lua_rawgeti(L, rec, REC_OP);
+	  if (lua_tointeger(L, -1) == EV_OP_WAIT) {
+	    lua_pop(L, 1);
+	    lua_pushboolean(L, 0);
+	    ev_wake(L, st, rec, 1);
+	  } else {
+	    lua_pop(L, 1);
+	    lua_pushnil(L);
+	    lua_pushliteral(L, "timeout");
+	    ev_wake(L, st, rec, 2);
+	  }
+	}
+	lua_pop(L, 2);
+      }
+      continue;
+    }
+    if ((e & (EPOLLIN|EPOLLHUP|EPOLLERR))) {
+      ev_tab(L, EV_RD);
+      lua_rawgeti(L, -1, fd);
+      if (lua_istable(L, -1)) ev_complete(L, st, lua_gettop(L));
+      lua_pop(L, 2);
+    }
+    if ((e & (EPOLLOUT|EPOLLHUP|EPOLLERR))) {
+      ev_tab(L, EV_WR);
+      lua_rawgeti(L, -1, fd);
+      if (lua_istable(L, -1)) ev_complete(L, st, lua_gettop(L));
+      lua_pop(L, 2);
+    }
+  }
+}
+
+/* Resume the next coroutine from the ready queue. */
+static void ev_step(lua_State *L, EvState *st)
+{
+  int32_t base = st->rqhead++ * 3;
+  lua_State *co;
+  int nargs, status, i;
+  ev_tab(L, EV_RQ);
+  lua_rawgeti(L, -1, base+1);
+  lua_rawgeti(L, -2, base+2);
+  lua_rawgeti(L, -3, base+3);
+  for (i = 1; i <= 3; i++) {
+    lua_pushnil(L);
+    lua_rawseti(L, -5, base+i);
+  }
+  co = lua_tothread(L, -3);
+  if (lua_touserdata(L, -2) == (void *)st) {  /* Started by spawn(). */
+    nargs = lua_gettop(co) - 1;
+    lua_pop(L, 2);
+  } else {
+    nargs = lua_isnil(L, -1) ? 1 : 2;
+    if (nargs == 1) lua_pop(L, 1);
+    lua_xmove(L, co, nargs);
+  }
+  st->waiting = 0;
+  status = lua_resume(co, nargs);
+  if (status == LUA_YIELD) {
+    if (!st->waiting) {  /* Plain coroutine.yield(): run again later. */
+      lua_settop(co, 0);
+      lua_pushvalue(L, -1);
+      lua_pushboolean(L, 1);
+      lua_pushnil(L);
+      ev_ready(L, st);
+    }
+  } else {
+    ev_tab(L, EV_CO);
+    lua_pushvalue(L, -2);
+    lua_pushnil(L);
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+    if (status != 0) {
+      st->running = 0;  /* Others stay queued for the next ev.run(). */
+      lua_xmove(co, L, 1);
+      lua_error(L);
+    }
+  }
+  lua_pop(L, 2);
+}
+
+/*
+** Switch a descriptor to non-blocking mode. This isn't cached, since the
+** descriptor may be closed and reused behind our back.
+*/
+static void ev_nonblock(int fd)
+{
+  int fl = fcntl(fd, F_GETFL);
+  if (fl >= 0 && !(fl & O_NONBLOCK))
+    fcntl(fd, F_SETFL, fl | O_NONBLOCK);
+}
+
+/* -- Event library functions --------------------------------------------- */
+
+static int lj_cf_io_event_spawn(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  int n = lua_gettop(L);
+  lua_State *co;
+  lj_lib_checkfunc(L, 1);
+  co = lua_newthread(L);
+  lua_insert(L, 1);
+  lua_xmove(L, co, n);
+  ev_tab(L, EV_CO);
+  lua_pushvalue(L, 1);
+  lua_pushboolean(L, 1);
+  lua_rawset(L, -3);
+  lua_pop(L, 1);
+  lua_pushvalue(L, 1);
+  ev_tab(L, EV_STATE);  /* Marks a new coroutine. */
+  lua_pushnil(L);
+  ev_ready(L, st);
+  return 1;
+}
+
+static int lj_cf_io_event_run(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  if (st->running)
+    lj_err_caller(L, LJ_ERR_IOEVRUN);
+  st->running = 1;
+  for (;;) {
+    while (st->rqhead < st->rqtail)
+      ev_step(L, st);
+    st->rqhead = st->rqtail = 0;
+    if (st->nwait == 0) break;
+    ev_poll(L, st);
+  }
+  st->running = 0;
+  return 0;
+}
+
+static int lj_cf_io_event_wait(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  int fd = ev_checkfd(L, 1);
+  GCstr *mode = lj_lib_optstr(L, 2);
+  double t = ev_opttime(L, 3);
+  int dir = EV_DIR_READ;
+  if (mode) {
+    const char *m = strdata(mode);
+    if (m[0] == 'w' && m[1] == '\0') dir = EV_DIR_WRITE;
+    else if (!(m[0] == 'r' && m[1] == '\0'))
+      lj_err_arg(L, 2, LJ_ERR_INVOPT);
+  }
+  ev_checkco(L);
+  lua_settop(L, 0);
+  ev_newrec(L, fd, dir, EV_OP_WAIT);
+  return ev_wait(L, st, t);
+}
+
+static int lj_cf_io_event_sleep(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  double t = lj_lib_checknum(L, 1);
+  ev_checkco(L);
+  lua_settop(L, 0);
+  ev_newrec(L, -1, 0, EV_OP_WAIT);
+  return ev_wait(L, st, t < 0.0 ? 0.0 : t);
+}
+
+static int lj_cf_io_event_read(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  int fd = ev_checkfd(L, 1);
+  int32_t sz = lj_lib_optint(L, 2, EV_READMAX);
+  double t = ev_opttime(L, 3);
+  char *buf;
+  ssize_t n;
+  if (sz <= 0)
+    lj_err_arg(L, 2, LJ_ERR_BADVAL);
+  ev_checkco(L);
+  ev_nonblock(fd);
+  buf = lj_buf_tmp(L, (MSize)sz);
+  do {
+    n = read(fd, buf, (size_t)sz);
+  } while (n < 0 && errno == EINTR);
+  if (n > 0) {
+    lua_pushlstring(L, buf, (size_t)n);
+    return 1;
+  } else if (n == 0) {
+    lua_pushnil(L);
+    return 1;
+  } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+    return ev_errresult(L, errno);
+  }
+  lua_settop(L, 0);
+  ev_newrec(L, fd, EV_DIR_READ, EV_OP_READ);
+  lua_pushinteger(L, sz);
+  lua_rawseti(L, -2, REC_DATA);
+  return ev_wait(L, st, t);
+}
+
+static int lj_cf_io_event_write(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  int fd = ev_checkfd(L, 1);
+  GCstr *s = lj_lib_checkstr(L, 2);
+  double t = ev_opttime(L, 3);
+  size_t ofs = 0;
+  ev_checkco(L);
+  ev_nonblock(fd);
+  while (ofs < s->len) {
+    ssize_t n = write(fd, strdata(s) + ofs, s->len - ofs);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return ev_errresult(L, errno);
+    }
+    ofs += (size_t)n;
+  }
+  if (ofs == s->len) {
+    setboolV(L->top++, 1);
+    return 1;
+  }
+  lua_settop(L, 2);
+  ev_newrec(L, fd, EV_DIR_WRITE, EV_OP_WRITE);
+  lua_pushvalue(L, 2);
+  lua_rawseti(L, -2, REC_DATA);
+  lua_pushinteger(L, (lua_Integer)ofs);
+  lua_rawseti(L, -2, REC_OFS);
+  return ev_wait(L, st, t);
+}
+
+static int lj_cf_io_event_close(lua_State *L)
+{
+  EvState *st = ev_state(L);
+  int fd = (int)lj_lib_checkint(L, 1), dir;
+  for (dir = EV_RD; dir <= EV_WR; dir++) {
+    ev_tab(L, dir);
+    lua_rawgeti(L, -1, fd);
+    if (lua_istable(L, -1)) {
+      int rec = lua_gettop(L);
+      lua_pushnil(L);
+      lua_pushliteral(L, "closed");
+      ev_wake(L, st, rec, 2);
+    }
+    lua_pop(L, 2);
+  }
+  if (close(fd) != 0)
+    return ev_errresult(L, errno);
+  setboolV(L->top++, 1);
+  return 1;
+}
+
+static int lj_cf_io_event_pipe(lua_State *L)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    return ev_errresult(L, errno);
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+  fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+  lua_pushinteger(L, fds[0]);
+  lua_pushinteger(L, fds[1]);
+  return 2;
+}
+
+static int lj_cf_io_event_socketpair(lua_State *L)
+{
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0, fds) != 0)
+    return ev_errresult(L, errno);
+  lua_pushinteger(L, fds[0]);
+  lua_pushinteger(L, fds[1]);
+  return 2;
+}
+
+static int lj_cf_io_event_now(lua_State *L)
+{
+  setnumV(L->top++, ev_now());
+  return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+static const luaL_Reg event_lib[] = {
+  { "spawn",	lj_cf_io_event_spawn },
+  { "run",	lj_cf_io_event_run },
+  { "wait",	lj_cf_io_event_wait },
+  { "sleep",	lj_cf_io_event_sleep },
+  { "read",	lj_cf_io_event_read },
+  { "write",	lj_cf_io_event_write },
+  { "close",	lj_cf_io_event_close },
+  { "pipe",	lj_cf_io_event_pipe },
+  { "socketpair", lj_cf_io_event_socketpair },
+  { "now",	lj_cf_io_event_now },
+  { NULL, NULL }
+};
+
+int luaopen_io_event(lua_State *L)
+{
+  EvState *st;
+  int i;
+  lua_createtable(L, EV__MAX-1, 0);
+  for (i = EV_CO; i < EV__MAX; i++) {
+    lua_newtable(L);
+    lua_rawseti(L, -2, i);
+  }
+  st = (EvState *)lua_newuserdata(L, sizeof(EvState));
+  memset(st, 0, sizeof(EvState));
+  st->epfd = st->tfd = -1;
+  lua_createtable(L, 0, 1);
+  lua_pushcfunction(L, ev_gc);
+  lua_setfield(L, -2, "__gc");
+  lua_setmetatable(L, -2);
+  lua_rawseti(L, -2, EV_STATE);
+  lua_replace(L, LUA_ENVIRONINDEX);  /* Inherited by the functions below. */
+  lua_newtable(L);
+  luaL_register(L, NULL, event_lib);
+  return 1;
+}
+
+#else
+
+#include "lj_err.h"
+
+int luaopen_io_event(lua_State *L)
+{
+  lj_err_caller(L, LJ_ERR_IOEVOS);
+  return 0;  /* unreachable */
+}
+
+#endif
@@ -23,21 +23,17 @@
 #include "lj_str.h"
 #include "lj_state.h"
 #include "lj_strfmt.h"
+#include "lj_io.h"
+#include "lj_vm.h"
 #include "lj_ff.h"
 #include "lj_lib.h"
 
-/* Userdata payload for I/O file. */
-typedef struct IOFileUD {
-  FILE *fp;		/* File handle. */
-  uint32_t type;	/* File type. */
-} IOFileUD;
-
-#define IOFILE_TYPE_FILE	0	/* Regular file. */
-#define IOFILE_TYPE_PIPE	1	/* Pipe. */
-#define IOFILE_TYPE_STDF	2	/* Standard file handle. */
-#define IOFILE_TYPE_MASK	3
-
-#define IOFILE_FLAG_CLOSE	4	/* Close after io.lines() iterator. */
+#if LJ_TARGET_POSIX
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
 
 #define IOSTDF_UD(L, id)	(&gcref(G(L)->gcroot[(id)])->ud)
 #define IOSTDF_IOF(L, id)	((IOFileUD *)uddata(IOSTDF_UD(L, (id))))
@@ -75,7 +71,7 @@ static IOFileUD *io_file_new(lua_State *L)
   ud->udtype = UDTYPE_IO_FILE;
   /* NOBARRIER: The GCudata is new (marked white). */
   setgcrefr(ud->metatable, curr_func(L)->c.env);
-  iof->fp = NULL;
+  memset(iof, 0, sizeof(IOFileUD));
   iof->type = IOFILE_TYPE_FILE;
   return iof;
 }
@@ -121,10 +117,27 @@ static int io_file_close(lua_State *L, IOFileUD *iof)
 
 /* -- Read/write helpers -------------------------------------------------- */
 
-static int io_file_readnum(lua_State *L, FILE *fp)
+#if LJ_32 && defined(__ANDROID__) && __ANDROID_API__ < 24
+/* The Android NDK is such an unmatched marvel of engineering. */
+extern int fseeko32(FILE *, long int, int) __asm__("fseeko");
+extern long int ftello32(FILE *) __asm__("ftello");
+#define fseeko(fp, pos, whence)	(fseeko32((fp), (pos), (whence)))
+#define ftello(fp)		(ftello32((fp)))
+#endif
+
+static int io_file_readnum(lua_State *L, IOFileUD *iof)
 {
   lua_Number d;
-  if (fscanf(fp, LUA_NUMBER_SCAN, &d) == 1) {
+  int ok;
+#if LJ_TARGET_POSIX
+  if ((iof->type & IOFILE_FLAG_MAP)) {  /* Let stdio parse at the map pos. */
+    ok = fseeko(iof->fp, (off_t)iof->mappos, SEEK_SET) == 0 &&
+	 fscanf(iof->fp, LUA_NUMBER_SCAN, &d) == 1;
+    iof->mappos = (size_t)ftello(iof->fp);
+  } else
+#endif
+  ok = fscanf(iof->fp, LUA_NUMBER_SCAN, &d) == 1;
+  if (ok) {
     if (LJ_DUALNUM) {
       int32_t i = lj_num2int(d);
       if (d == (lua_Number)i && !tvismzero((cTValue *)&d)) {
@@ -140,29 +153,43 @@ static int io_file_readnum(lua_State *L, FILE *fp)
   }
 }
 
-static int io_file_readline(lua_State *L, FILE *fp, MSize chop)
+static int io_file_readline(lua_State *L, IOFileUD *iof, MSize chop)
 {
-  MSize m = LUAL_BUFFERSIZE, n = 0, ok = 0;
-  char *buf;
-  for (;;) {
-    buf = lj_buf_tmp(L, m);
-    if (fgets(buf+n, m-n, fp) == NULL) break;
-    n += (MSize)strlen(buf+n);
-    ok |= n;
-    if (n && buf[n-1] == '\n') { n -= chop; break; }
-    if (n >= m - 64) m += m;
-  }
-  setstrV(L, L->top++, lj_str_new(L, buf, (size_t)n));
+  GCstr *str = lj_io_readline(L, iof, (int32_t)chop);
+  setstrV(L, L->top++, str ? str : &G(L)->strempty);
   lj_gc_check(L);
-  return (int)ok;
+  return str != NULL;
 }
 
-static void io_file_readall(lua_State *L, FILE *fp)
+/* Number of bytes left in the mapping. */
+#define io_mapleft(iof) \
+  ((iof)->mappos < (iof)->mapsz ? (iof)->mapsz - (iof)->mappos : 0)
+
+static void io_file_readall(lua_State *L, IOFileUD *iof)
 {
   MSize m, n;
-  for (m = LUAL_BUFFERSIZE, n = 0; ; m += m) {
+  if ((iof->type & IOFILE_FLAG_MAP)) {  /* Copy straight from the mapping. */
+    size_t len = io_mapleft(iof);
+    setstrV(L, L->top++, len ? lj_str_new(L, iof->map + iof->mappos, len) :
+			       &G(L)->strempty);
+    iof->mappos += len;
+    lj_gc_check(L);
+    return;
+  }
+  m = LUAL_BUFFERSIZE;
+#if LJ_TARGET_POSIX
+  {  /* Pre-size for the rest of a regular file. Then one fread() is enough. */
+    struct stat st;
+    off_t pos;
+    if (fstat(fileno(iof->fp), &st) == 0 && S_ISREG(st.st_mode) &&
+	(pos = ftello(iof->fp)) >= 0 && st.st_size > pos &&
+	st.st_size - pos < LJ_MAX_BUF)
+      m = (MSize)(st.st_size - pos) + 1;
+  }
+#endif
+  for (n = 0; ; m += m) {
     char *buf = lj_buf_tmp(L, m);
-    n += (MSize)fread(buf+n, 1, m-n, fp);
+    n += (MSize)fread(buf+n, 1, m-n, iof->fp);
     if (n != m) {
       setstrV(L, L->top++, lj_str_new(L, buf, (size_t)n));
       lj_gc_check(L);
@@ -171,9 +198,18 @@ static void io_file_readall(lua_State *L, FILE *fp)
   }
 }
 
-static int io_file_readlen(lua_State *L, FILE *fp, MSize m)
+static int io_file_readlen(lua_State *L, IOFileUD *iof, MSize m)
 {
-  if (m) {
+  FILE *fp = iof->fp;
+  if ((iof->type & IOFILE_FLAG_MAP)) {
+    size_t len = io_mapleft(iof);
+    if (len > m) len = m;
+    setstrV(L, L->top++, len ? lj_str_new(L, iof->map + iof->mappos, len) :
+			       &G(L)->strempty);
+    iof->mappos += len;
+    lj_gc_check(L);
+    return m ? len > 0 : io_mapleft(iof) > 0;
+  } else if (m) {
     char *buf = lj_buf_tmp(L, m);
     MSize n = (MSize)fread(buf, 1, m, fp);
     setstrV(L, L->top++, lj_str_new(L, buf, (size_t)n));
@@ -193,7 +229,7 @@ static int io_file_read(lua_State *L, IOFileUD *iof, int start)
   int ok, n, nargs = (int)(L->top - L->base) - start;
   clearerr(fp);
   if (nargs == 0) {
-    ok = io_file_readline(L, fp, 1);
+    ok = io_file_readline(L, iof, 1);
     n = start+1;  /* Return 1 result. */
   } else {
     /* The results plus the buffers go on top of the args. */
@@ -204,15 +240,20 @@ static int io_file_read(lua_State *L, IOFileUD *iof, int start)
 	const char *p = strVdata(L->base+n);
 	if (p[0] == '*') p++;
 	if (p[0] == 'n')
-	  ok = io_file_readnum(L, fp);
+	  ok = io_file_readnum(L, iof);
 	else if ((p[0] & ~0x20) == 'L')
-	  ok = io_file_readline(L, fp, (p[0] == 'l'));
+	  ok = io_file_readline(L, iof, (p[0] == 'l'));
 	else if (p[0] == 'a')
-	  io_file_readall(L, fp);
+	  io_file_readall(L, iof);
 	else
 	  lj_err_arg(L, n+1, LJ_ERR_INVFMT);
+#if LJ_HASBUFFER
+      } else if (tvisbuf(L->base+n)) {  /* Read line into buffer object. */
+	ok = lj_io_readline_buf(L, bufV(L->base+n), iof, 1);
+	copyTV(L, L->top++, L->base+n);
+#endif
       } else if (tvisnumber(L->base+n)) {
-	ok = io_file_readlen(L, fp, (MSize)lj_lib_checkint(L, n+1));
+	ok = io_file_readlen(L, iof, (MSize)lj_lib_checkint(L, n+1));
       } else {
 	lj_err_arg(L, n+1, LJ_ERR_INVOPT);
       }
@@ -225,17 +266,59 @@ static int io_file_read(lua_State *L, IOFileUD *iof, int start)
   return n - start;
 }
 
+#define IO_COALESCE_MIN	LUAL_BUFFERSIZE	/* Coalesce bigger writes ... */
+#define IO_COALESCE_MAX	(1<<20)		/* ... up to this size. */
+
+/* Append a string, buffer or number argument to a buffer. */
+static void io_putarg(lua_State *L, SBuf *sb, cTValue *tv, int narg)
+{
+  if (tvisint(tv)) {
+    lj_strfmt_putint(sb, intV(tv));
+  } else if (tvisnum(tv)) {
+    lj_strfmt_putfnum(sb, STRFMT_G14, numV(tv));
+  } else {
+    MSize len;
+    const char *p = lj_strfmt_wstrnum(L, tv, &len);
+    if (!p)
+      lj_err_argt(L, narg, LUA_TSTRING);
+    lj_buf_putmem(sb, p, len);
+  }
+}
+
+/* Total size of the arguments. Numbers count with their max. size. */
+static size_t io_argsize(cTValue *tv, cTValue *te)
+{
+  size_t total = 0;
+  for (; tv < te; tv++) {
+    if (tvisstr(tv)) total += strV(tv)->len;
+    else if (tvisbuf(tv)) total += sbufxlen(bufV(tv));
+    else total += STRFMT_MAXBUF_NUM;
+  }
+  return total;
+}
+
 static int io_file_write(lua_State *L, IOFileUD *iof, int start)
 {
   FILE *fp = iof->fp;
   cTValue *tv;
   int status = 1;
-  for (tv = L->base+start; tv < L->top; tv++) {
-    MSize len;
-    const char *p = lj_strfmt_wstrnum(L, tv, &len);
-    if (!p)
-      lj_err_argt(L, (int)(tv - L->base) + 1, LUA_TSTRING);
-    status = status && (fwrite(p, 1, len, fp) == len);
+  size_t total;
+  if ((L->top - L->base) - start > 1 &&
+      (total = io_argsize(L->base+start, L->top)) >= IO_COALESCE_MIN &&
+      total <= IO_COALESCE_MAX) {
+    /* Big pieces bypass the stdio buffer, so write them with one fwrite(). */
+    SBuf *sb = lj_buf_tmp_(L);
+    for (tv = L->base+start; tv < L->top; tv++)
+      io_putarg(L, sb, tv, (int)(tv - L->base) + 1);
+    status = (fwrite(sb->b, 1, sbuflen(sb), fp) == sbuflen(sb));
+  } else {
+    for (tv = L->base+start; tv < L->top; tv++) {
+      MSize len;
+      const char *p = lj_strfmt_wstrnum(L, tv, &len);
+      if (!p)
+	lj_err_argt(L, (int)(tv - L->base) + 1, LUA_TSTRING);
+      status = status && (fwrite(p, 1, len, fp) == len);
+    }
   }
   if (LJ_52 && status) {
     L->top = L->base+1;
@@ -246,38 +329,6 @@ static int io_file_write(lua_State *L, IOFileUD *iof, int start)
   return luaL_fileresult(L, status, NULL);
 }
 
-static int io_file_iter(lua_State *L)
-{
-  GCfunc *fn = curr_func(L);
-  IOFileUD *iof = uddata(udataV(&fn->c.upvalue[0]));
-  int n = fn->c.nupvalues - 1;
-  if (iof->fp == NULL)
-    lj_err_caller(L, LJ_ERR_IOCLFL);
-  L->top = L->base;
-  if (n) {  /* Copy upvalues with options to stack. */
-    lj_state_checkstack(L, (MSize)n);
-    memcpy(L->top, &fn->c.upvalue[1], n*sizeof(TValue));
-    L->top += n;
-  }
-  n = io_file_read(L, iof, 0);
-  if (ferror(iof->fp))
-    lj_err_callermsg(L, strVdata(L->top-2));
-  if (tvisnil(L->base) && (iof->type & IOFILE_FLAG_CLOSE)) {
-    io_file_close(L, iof);  /* Return values are ignored. */
-    return 0;
-  }
-  return n;
-}
-
-static int io_file_lines(lua_State *L)
-{
-  int n = (int)(L->top - L->base);
-  if (n > LJ_MAX_UPVAL)
-    lj_err_caller(L, LJ_ERR_UNPACK);
-  lua_pushcclosure(L, io_file_iter, n);
-  return 1;
-}
-
 /* -- I/O file methods ---------------------------------------------------- */
 
 #define LJLIB_MODULE_io_method
@@ -310,17 +361,10 @@ LJLIB_CF(io_method_flush)		LJLIB_REC(io_flush 0)
   return luaL_fileresult(L, fflush(io_tofile(L)->fp) == 0, NULL);
 }
 
-#if LJ_32 && defined(__ANDROID__) && __ANDROID_API__ < 24
-/* The Android NDK is such an unmatched marvel of engineering. */
-extern int fseeko32(FILE *, long int, int) __asm__("fseeko");
-extern long int ftello32(FILE *) __asm__("ftello");
-#define fseeko(fp, pos, whence)	(fseeko32((fp), (pos), (whence)))
-#define ftello(fp)		(ftello32((fp)))
-#endif
-
 LJLIB_CF(io_method_seek)
 {
-  FILE *fp = io_tofile(L)->fp;
+  IOFileUD *iof = io_tofile(L);
+  FILE *fp = iof->fp;
   int opt = lj_lib_checkopt(L, 2, 1, "\3set\3cur\3end");
   int64_t ofs = 0;
   cTValue *o;
@@ -337,6 +381,17 @@ LJLIB_CF(io_method_seek)
     else if (!tvisnil(o))
       lj_err_argt(L, 3, LUA_TNUMBER);
   }
+  if ((iof->type & IOFILE_FLAG_MAP)) {  /* Only move the map position. */
+    if (opt == SEEK_CUR) ofs += (int64_t)iof->mappos;
+    else if (opt == SEEK_END) ofs += (int64_t)iof->mapsz;
+    if (ofs < 0) {
+      errno = EINVAL;
+      return luaL_fileresult(L, 0, NULL);
+    }
+    iof->mappos = (size_t)ofs;
+    setint64V(L->top-1, ofs);
+    return 1;
+  }
 #if LJ_TARGET_POSIX
   res = fseeko(fp, ofs, opt);
 #elif _MSC_VER >= 1400
@@ -372,6 +427,38 @@ LJLIB_CF(io_method_setvbuf)
   return luaL_fileresult(L, setvbuf(fp, NULL, opt, sz) == 0, NULL);
 }
 
+LJLIB_NOREG LJLIB_CF(io_lines_iter)	LJLIB_REC(.)
+{
+  GCfunc *fn = curr_func(L);
+  IOFileUD *iof = uddata(udataV(&fn->c.upvalue[0]));
+  int n = fn->c.nupvalues - 1;
+  if (iof->fp == NULL)
+    lj_err_caller(L, LJ_ERR_IOCLFL);
+  L->top = L->base;
+  if (n) {  /* Copy upvalues with options to stack. */
+    lj_state_checkstack(L, (MSize)n);
+    memcpy(L->top, &fn->c.upvalue[1], n*sizeof(TValue));
+    L->top += n;
+  }
+  n = io_file_read(L, iof, 0);
+  if (ferror(iof->fp))
+    lj_err_callermsg(L, strVdata(L->top-2));
+  if (tvisnil(L->base) && (iof->type & IOFILE_FLAG_CLOSE)) {
+    io_file_close(L, iof);  /* Return values are ignored. */
+    return 0;
+  }
+  return n;
+}
+
+static int io_file_lines(lua_State *L)
+{
+  int n = (int)(L->top - L->base);
+  if (n > LJ_MAX_UPVAL)
+    lj_err_caller(L, LJ_ERR_UNPACK);
+  lj_lib_pushcc(L, lj_cf_io_lines_iter, FF_io_lines_iter, n);
+  return 1;
+}
+
 LJLIB_CF(io_method_lines)
 {
   io_tofile(L);
@@ -383,6 +470,10 @@ LJLIB_CF(io_method___gc)
   IOFileUD *iof = io_tofilep(L);
   if (iof->fp != NULL && (iof->type & IOFILE_TYPE_MASK) != IOFILE_TYPE_STDF)
     io_file_close(L, iof);
+#if LJ_TARGET_POSIX
+  if ((iof->type & IOFILE_FLAG_MAP))
+    lj_io_unmap(iof);  /* Buffer views of the mapping keep the file alive. */
+#endif
   return 0;
 }
 
@@ -412,8 +503,26 @@ LJLIB_CF(io_open)
   GCstr *s = lj_lib_optstr(L, 2);
   const char *mode = s ? strdata(s) : "r";
   IOFileUD *iof = io_file_new(L);
+  char mbuf[8];
+  int map = 0;
+  if (strchr(mode, 'm') && s->len < sizeof(mbuf)) {  /* "rm": map file. */
+    char *q = mbuf;
+    const char *p;
+    for (p = mode; *p; p++)
+      if (*p != 'm') *q++ = *p;
+    *q = '\0';
+    mode = mbuf;
+    map = (mode[0] == 'r' && !strchr(mode, '+'));
+  }
   iof->fp = fopen(fname, mode);
-  return iof->fp != NULL ? 1 : luaL_fileresult(L, 0, fname);
+  if (iof->fp == NULL)
+    return luaL_fileresult(L, 0, fname);
+#if LJ_TARGET_POSIX
+  if (map) lj_io_map(iof);  /* Falls back to stdio, e.g. for pipes. */
+#else
+  UNUSED(map);
+#endif
+  return 1;
 }
 
 LJLIB_CF(io_popen)
@@ -500,6 +609,7 @@ LJLIB_CF(io_lines)
   if (!tvisnil(L->base)) {  /* io.lines(fname) */
     IOFileUD *iof = io_file_open(L, "r");
     iof->type = IOFILE_TYPE_FILE|IOFILE_FLAG_CLOSE;
+    setvbuf(iof->fp, NULL, _IOFBF, LJ_IO_LINESBUF);  /* Private handle. */
     L->top--;
     setudataV(L, L->base, udataV(L->top));
   } else {  /* io.lines() iterates over stdin. */
@@ -508,6 +618,165 @@ LJLIB_CF(io_lines)
   return io_file_lines(L);
 }
 
+/* State of io.readfile(). */
+typedef struct IOReadFile {
+  SBuf *sb;		/* Destination buffer. */
+#if LJ_TARGET_POSIX
+  int fd;		/* File descriptor. */
+#else
+  FILE *fp;		/* File handle. */
+#endif
+  int ok;		/* Read was successful. */
+} IOReadFile;
+
+/* Read the whole file. Protected, since growing the buffer may throw. */
+static TValue *io_cpreadfile(lua_State *L, lua_CFunction dummy, void *ud)
+{
+  IOReadFile *rf = (IOReadFile *)ud;
+  SBuf *sb = rf->sb;
+  MSize sz = LUAL_BUFFERSIZE;
+#if LJ_TARGET_POSIX
+  struct stat st;
+  int isreg = fstat(rf->fd, &st) == 0 && S_ISREG(st.st_mode);
+  if (isreg && st.st_size < LJ_MAX_BUF)
+    sz = (MSize)st.st_size + 1;  /* A short read() marks the end. */
+#endif
+  UNUSED(L); UNUSED(dummy);
+  for (;;) {
+    char *w = lj_buf_more(sb, sz);
+    MSize m = sbufleft(sb);
+#if LJ_TARGET_POSIX
+    ssize_t n = read(rf->fd, w, m);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return NULL;
+    }
+#else
+    size_t n = fread(w, 1, m, rf->fp);
+    if (ferror(rf->fp)) return NULL;
+#endif
+    sb->w = w + n;
+#if LJ_TARGET_POSIX
+    if (n == 0 || (isreg && (MSize)n < m)) break;
+#else
+    if ((MSize)n < m) break;
+#endif
+    if ((MSize)n == m) sz += sz;  /* Only grow if the buffer filled up. */
+  }
+  rf->ok = 1;
+  return NULL;
+}
+
+LJLIB_CF(io_readfile)
+{
+  const char *fname = strdata(lj_lib_checkstr(L, 1));
+  IOReadFile rf;
+  int errcode, err;
+#if LJ_HASBUFFER
+  if (L->base+1 < L->top && tvisbuf(L->base+1)) {  /* Append to buffer. */
+    SBufExt *sbx = bufV(L->base+1);
+    setsbufXL_(sbx, L);
+    rf.sb = (SBuf *)sbx;
+  } else
+#endif
+  rf.sb = lj_buf_tmp_(L);
+  rf.ok = 0;
+#if LJ_TARGET_POSIX
+  if ((rf.fd = open(fname, O_RDONLY)) < 0)
+    return luaL_fileresult(L, 0, fname);
+#else
+  if ((rf.fp = fopen(fname, "rb")) == NULL)
+    return luaL_fileresult(L, 0, fname);
+#endif
+  errcode = lj_vm_cpcall(L, NULL, &rf, io_cpreadfile);
+  err = errno;
+#if LJ_TARGET_POSIX
+  close(rf.fd);
+#else
+  fclose(rf.fp);
+#endif
+  if (errcode) lj_err_throw(L, errcode);
+  if (!rf.ok) {
+    errno = err;
+    return luaL_fileresult(L, 0, fname);
+  }
+  if (rf.sb == &G(L)->tmpbuf) {
+    setstrV(L, L->top++, lj_buf_str(L, rf.sb));
+    lj_gc_check(L);
+  } else {
+    L->top = L->base+2;  /* Return buffer object. */
+  }
+  return 1;
+}
+
+#if LJ_TARGET_POSIX
+#define IO_MAXIOV	64	/* Max. number of pieces per writev(). */
+
+/* Write all pieces, retrying after partial writes. */
+static int io_writev(int fd, struct iovec *iov, int n)
+{
+  while (n > 0) {
+    ssize_t w = writev(fd, iov, n);
+    if (w < 0) {
+      if (errno == EINTR) continue;
+      return 0;
+    }
+    for (; n > 0 && (size_t)w >= iov->iov_len; iov++, n--)
+      w -= (ssize_t)iov->iov_len;
+    if (n > 0) {
+      iov->iov_base = (char *)iov->iov_base + w;
+      iov->iov_len -= (size_t)w;
+    }
+  }
+  return 1;
+}
+#endif
+
+LJLIB_CF(io_writefile)
+{
+  const char *fname = strdata(lj_lib_checkstr(L, 1));
+  TValue *tv;
+  int ok;
+  /* Convert all arguments before opening the file, since this may throw. */
+  for (tv = L->base+1; tv < L->top; tv++) {
+    if (tvisnumber(tv))
+      setstrV(L, tv, lj_strfmt_number(L, tv));
+    else if (!(tvisstr(tv) || tvisbuf(tv)))
+      lj_err_argt(L, (int)(tv - L->base) + 1, LUA_TSTRING);
+  }
+  {
+#if LJ_TARGET_POSIX
+    struct iovec iov[IO_MAXIOV];
+    int fd = open(fname, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    ok = fd >= 0;
+    for (tv = L->base+1; ok && tv < L->top; ) {
+      int n;
+      for (n = 0; tv < L->top && n < IO_MAXIOV; tv++, n++) {
+	MSize len;
+	iov[n].iov_base = (void *)lj_strfmt_wstrnum(L, tv, &len);
+	iov[n].iov_len = len;
+      }
+      ok = io_writev(fd, iov, n);
+    }
+    if (fd >= 0) {
+      int err = errno;
+      if (close(fd) != 0) ok = 0; else if (!ok) errno = err;
+    }
+#else
+    FILE *fp = fopen(fname, "wb");
+    ok = fp != NULL;
+    for (tv = L->base+1; ok && tv < L->top; tv++) {
+      MSize len;
+      const char *p = lj_strfmt_wstrnum(L, tv, &len);
+      ok = (fwrite(p, 1, len, fp) == len);
+    }
+    if (fp && fclose(fp) != 0) ok = 0;
+#endif
+  }
+  lj_gc_check(L);
+  return luaL_fileresult(L, ok, fname);
+}
+
 LJLIB_CF(io_type)
 {
   cTValue *o = lj_lib_checkany(L, 1);
@@ -531,6 +800,7 @@ static GCobj *io_std_new(lua_State *L, FILE *fp, const char *name)
   ud->udtype = UDTYPE_IO_FILE;
   /* NOBARRIER: The GCudata is new (marked white). */
   setgcref(ud->metatable, gcV(L->top-3));
+  memset(iof, 0, sizeof(IOFileUD));
   iof->fp = fp;
   iof->type = IOFILE_TYPE_STDF;
   lua_setfield(L, -2, name);
@@ -546,6 +816,9 @@ LUALIB_API int luaopen_io(lua_State *L)
   setgcref(G(L)->gcroot[GCROOT_IO_INPUT], io_std_new(L, stdin, "stdin"));
   setgcref(G(L)->gcroot[GCROOT_IO_OUTPUT], io_std_new(L, stdout, "stdout"));
   io_std_new(L, stderr, "stderr");
+#if LJ_TARGET_LINUX
+  lj_lib_prereg(L, LUA_IOLIBNAME ".event", luaopen_io_event, tabV(L->top-1));
+#endif
   return 1;
 }
 
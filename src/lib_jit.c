@@ -19,6 +19,7 @@
 #include "lj_tab.h"
 #include "lj_state.h"
 #include "lj_bc.h"
+#include "lj_bcdump.h"
 #if LJ_HASFFI
 #include "lj_ctype.h"
 #endif
@@ -33,6 +34,7 @@
 #include "lj_dispatch.h"
 #include "lj_vm.h"
 #include "lj_vmevent.h"
+#include "lj_image.h"
 #include "lj_lib.h"
 
 #include "luajit.h"
@@ -257,6 +259,8 @@ LJLIB_CF(jit_util_funck)
   } else {
     if (~idx < (ptrdiff_t)pt->sizekgc) {
       GCobj *gc = proto_kgc(pt, idx);
+      if (gc->gch.gct == ~LJ_TPROTO && proto_islazy(gco2pt(gc)))
+	gc = obj2gco(lj_bcread_lazy(L, pt, gco2pt(gc)));
       setgcV(L, L->top-1, gc, ~gc->gch.gct);
       return 1;
     }
@@ -634,6 +638,75 @@ static int luaopen_jit_profile(lua_State *L)
 
 #endif
 
+/* -- jit.image module ---------------------------------------------------- */
+
+/* Not loaded by default, use: local image = require("jit.image") */
+
+typedef struct ImageFile {
+  const char *name;
+  FILE *fp;		/* Opened on first write, after the image is complete. */
+} ImageFile;
+
+static int jit_image_writer(lua_State *L, const void *p, size_t sz, void *ud)
+{
+  ImageFile *f = (ImageFile *)ud;
+  UNUSED(L);
+  if (!f->fp && !(f->fp = fopen(f->name, "wb")))
+    return 1;
+  return fwrite(p, 1, sz, f->fp) != sz;
+}
+
+/* image.save(filename) */
+static int jit_image_save(lua_State *L)
+{
+  ImageFile f;
+  int err;
+  f.name = luaL_checkstring(L, 1);
+  f.fp = NULL;
+  err = lj_image_save(L, jit_image_writer, &f);
+  if (f.fp && fclose(f.fp) != 0)
+    err = 1;
+  if (err)
+    return luaL_fileresult(L, 0, f.name);
+  setboolV(L->top++, 1);
+  return 1;
+}
+
+/* image.load(filename) */
+static int jit_image_load(lua_State *L)
+{
+  const char *fname = luaL_checkstring(L, 1);
+  FILE *fp = fopen(fname, "rb");
+  long sz = -1;
+  char *p = NULL;
+  if (!fp)
+    return luaL_fileresult(L, 0, fname);
+  if (fseek(fp, 0, SEEK_END) == 0 && (sz = ftell(fp)) >= 0 &&
+      fseek(fp, 0, SEEK_SET) == 0 && (size_t)sz < LJ_MAX_UDATA) {
+    p = (char *)lua_newuserdata(L, (size_t)sz);
+    if (fread(p, 1, (size_t)sz, fp) != (size_t)sz)
+      p = NULL;
+  }
+  if (fclose(fp) != 0 || !p)
+    return luaL_fileresult(L, 0, fname);
+  lj_image_load(L, p, (size_t)sz);
+  setboolV(L->top++, 1);
+  return 1;
+}
+
+static const luaL_Reg jit_image_lib[] = {
+  { "save",	jit_image_save },
+  { "load",	jit_image_load },
+  { NULL,	NULL }
+};
+
+static int luaopen_jit_image(lua_State *L)
+{
+  lua_createtable(L, 0, 2);
+  luaL_register(L, NULL, jit_image_lib);
+  return 1;
+}
+
 /* -- JIT compiler initialization ----------------------------------------- */
 
 #if LJ_HASJIT
@@ -753,6 +826,7 @@ LUALIB_API int luaopen_jit(lua_State *L)
 #ifndef LUAJIT_DISABLE_JITUTIL
   lj_lib_prereg(L, LUA_JITLIBNAME ".util", luaopen_jit_util, tabref(L->env));
 #endif
+  lj_lib_prereg(L, LUA_JITLIBNAME ".image", luaopen_jit_image, tabref(L->env));
 #if LJ_HASJIT
   LJ_LIB_REG(L, "jit.opt", jit_opt);
 #endif
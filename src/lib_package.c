@@ -14,10 +14,22 @@
 #include "lauxlib.h"
 #include "lualib.h"
 
+#include "luajit.h"
+
 #include "lj_obj.h"
 #include "lj_err.h"
+#include "lj_bcdump.h"
 #include "lj_lib.h"
 
+#if LJ_TARGET_POSIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
 /* ------------------------------------------------------------------------ */
 
 /* Error codes for ll_loadfunc. */
@@ -236,6 +248,13 @@ static const char *mksymname(lua_State *L, const char *modname,
   return funcname;
 }
 
+/* Embedded bytecode is never freed, so inner functions may load lazily. */
+static int ll_loadbc(lua_State *L, const char *bcdata, const char *name)
+{
+  return lj_load_owned(L, obj2gco(&G(L)->strempty), bcdata, ~(size_t)0,
+		       name, NULL);
+}
+
 static int ll_loadfunc(lua_State *L, const char *path, const char *name, int r)
 {
   void **reg;
@@ -261,7 +280,7 @@ static int ll_loadfunc(lua_State *L, const char *path, const char *name, int r)
       const char *bcdata = ll_bcsym(*reg, mksymname(L, name, SYMPREFIX_BC));
       lua_pop(L, 1);
       if (bcdata) {
-	if (luaL_loadbuffer(L, bcdata, ~(size_t)0, name) != 0)
+	if (ll_loadbc(L, bcdata, name) != 0)
 	  return PACKAGE_ERR_LOAD;
 	return 0;
       }
@@ -303,6 +322,88 @@ static int readable(const char *filename)
   return 1;
 }
 
+#if LJ_TARGET_POSIX
+/*
+** The optional package.dircache table maps directory names to the set of
+** names in them, or to false if a directory can't be opened. Each directory
+** is listed once with readdir(). A directory that is missing from the
+** listing of its parent isn't even opened. Module lookups in paths with
+** many templates then need hardly any syscalls.
+*/
+
+static int dircache_find(lua_State *L, int idx, const char *dir, size_t dlen,
+			 const char *name, size_t nlen);
+
+/* Push the listing of a directory from the cache at index idx. */
+static void dircache_list(lua_State *L, int idx, const char *dir, size_t len)
+{
+  const char *sep;
+  DIR *dp;
+  luaL_checkstack(L, 4, "path too long");
+  lua_pushlstring(L, dir, len);
+  lua_pushvalue(L, -1);
+  lua_rawget(L, idx);
+  if (!lua_isnil(L, -1)) {
+    lua_remove(L, -2);
+    return;
+  }
+  lua_pop(L, 1);
+  for (sep = dir + len-1; sep > dir && *sep != *LUA_DIRSEP; sep--) ;
+  if (sep > dir && sep+1 < dir+len &&
+      !dircache_find(L, idx, dir, (size_t)(sep-dir), sep+1,
+		     (size_t)(dir+len - (sep+1)))) {
+    lua_pop(L, 1);
+    lua_pushboolean(L, 0);
+    return;
+  }
+  dp = opendir(lua_tostring(L, -1));
+  if (dp) {
+    struct dirent *de;
+    lua_newtable(L);
+    while ((de = readdir(dp)) != NULL) {
+      lua_pushstring(L, de->d_name);
+      lua_pushboolean(L, 1);
+      lua_rawset(L, -3);
+    }
+    closedir(dp);
+  } else {
+    lua_pushboolean(L, 0);
+  }
+  lua_pushvalue(L, -2);
+  lua_pushvalue(L, -2);
+  lua_rawset(L, idx);
+  lua_remove(L, -2);
+}
+
+static int dircache_find(lua_State *L, int idx, const char *dir, size_t dlen,
+			 const char *name, size_t nlen)
+{
+  int res = 0;
+  dircache_list(L, idx, dir, dlen);
+  if (lua_istable(L, -1)) {
+    lua_pushlstring(L, name, nlen);
+    lua_rawget(L, -2);
+    res = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+  }
+  lua_pop(L, 1);
+  return res;
+}
+
+/* Check whether a file exists according to the cache at index idx. */
+static int dircache_has(lua_State *L, int idx, const char *filename)
+{
+  const char *sep = strrchr(filename, *LUA_DIRSEP);
+  if (sep == NULL)
+    return dircache_find(L, idx, ".", 1, filename, strlen(filename));
+  return dircache_find(L, idx, filename,
+		       sep == filename ? 1 : (size_t)(sep-filename),
+		       sep+1, strlen(sep+1));
+}
+#else
+#define dircache_has(L, idx, filename)	1
+#endif
+
 static const char *pushnexttemplate(lua_State *L, const char *path)
 {
   const char *l;
@@ -316,7 +417,7 @@ static const char *pushnexttemplate(lua_State *L, const char *path)
 
 static const char *searchpath (lua_State *L, const char *name,
 			       const char *path, const char *sep,
-			       const char *dirsep)
+			       const char *dirsep, int cache)
 {
   luaL_Buffer msg;  /* to build error message */
   luaL_buffinit(L, &msg);
@@ -326,7 +427,7 @@ static const char *searchpath (lua_State *L, const char *name,
     const char *filename = luaL_gsub(L, lua_tostring(L, -1),
 				     LUA_PATH_MARK, name);
     lua_remove(L, -2);  /* remove path template */
-    if (readable(filename))  /* does file exist and is readable? */
+    if ((!cache || dircache_has(L, cache, filename)) && readable(filename))
       return filename;  /* return that file name */
     lua_pushfstring(L, "\n\tno file " LUA_QS, filename);
     lua_remove(L, -2);  /* remove file name */
@@ -341,7 +442,7 @@ static int lj_cf_package_searchpath(lua_State *L)
   const char *f = searchpath(L, luaL_checkstring(L, 1),
 				luaL_checkstring(L, 2),
 				luaL_optstring(L, 3, "."),
-				luaL_optstring(L, 4, LUA_DIRSEP));
+				luaL_optstring(L, 4, LUA_DIRSEP), 0);
   if (f != NULL) {
     return 1;
   } else {  /* error message is on top of the stack */
@@ -355,11 +456,14 @@ static const char *findfile(lua_State *L, const char *name,
 			    const char *pname)
 {
   const char *path;
+  int cache;
+  lua_getfield(L, LUA_ENVIRONINDEX, "dircache");
+  cache = lua_istable(L, -1) ? lua_gettop(L) : 0;
   lua_getfield(L, LUA_ENVIRONINDEX, pname);
   path = lua_tostring(L, -1);
   if (path == NULL)
     luaL_error(L, LUA_QL("package.%s") " must be a string", pname);
-  return searchpath(L, name, path, ".", LUA_DIRSEP);
+  return searchpath(L, name, path, ".", LUA_DIRSEP, cache);
 }
 
 static void loaderror(lua_State *L, const char *filename)
@@ -368,13 +472,362 @@ static void loaderror(lua_State *L, const char *filename)
 	     lua_tostring(L, 1), filename, lua_tostring(L, -1));
 }
 
+/* -- Bytecode cache ------------------------------------------------------ */
+
+#if LJ_TARGET_POSIX
+
+/*
+** Modules found by the Lua loader are cached as bytecode dumps in the
+** directory given by package.bccache. A cache file is named after a hash
+** of the real path of the source file. It starts with a header that holds
+** the VM version, the file name, its mtime and size. The dump is only used
+** if the whole header matches. Cache files are written to a temporary file
+** and renamed, so concurrent processes can share a cache directory.
+*/
+
+#define BCCACHE_FLAGS \
+  ((LJ_BE ? BCDUMP_F_BE : 0) | (LJ_HASFFI ? BCDUMP_F_FFI : 0) | \
+   (LJ_FR2 ? BCDUMP_F_FR2 : 0))
+
+typedef struct BCCacheReader {
+  FILE *fp;
+  char buf[LUAL_BUFFERSIZE];
+} BCCacheReader;
+
+static const char *bccache_reader(lua_State *L, void *ud, size_t *size)
+{
+  BCCacheReader *ctx = (BCCacheReader *)ud;
+  UNUSED(L);
+  if (feof(ctx->fp)) return NULL;
+  *size = fread(ctx->buf, 1, sizeof(ctx->buf), ctx->fp);
+  return *size > 0 ? ctx->buf : NULL;
+}
+
+static int bccache_writer(lua_State *L, const void *p, size_t sz, void *ud)
+{
+  UNUSED(L);
+  return fwrite(p, 1, sz, (FILE *)ud) != sz;
+}
+
+static const char *bccache_header(lua_State *L, const char *filename,
+				  const struct stat *st)
+{
+  char buf[64];
+  long nsec = 0;
+#if LJ_TARGET_LINUX
+  nsec = (long)st->st_mtim.tv_nsec;
+#endif
+  snprintf(buf, sizeof(buf), "%lld.%09ld %lld",
+	   (long long)st->st_mtime, nsec, (long long)st->st_size);
+  return lua_pushfstring(L, "LJBC " LUAJIT_VERSION " " LJ_ARCH_NAME " %d %d\n"
+			 "%s\n%s\n", BCDUMP_VERSION, BCCACHE_FLAGS, buf,
+			 filename);
+}
+
+static const char *bccache_name(lua_State *L, const char *dir,
+				const char *filename)
+{
+  char *real = realpath(filename, NULL);
+  const char *p = real ? real : filename;
+  uint64_t h = U64x(cbf29ce4,84222325);  /* FNV-1a. */
+  char hex[17];
+  int i;
+  for (; *p; p++) h = (h ^ (uint8_t)*p) * U64x(00000100,000001b3);
+  free(real);
+  for (i = 15; i >= 0; i--, h >>= 4) hex[i] = "0123456789abcdef"[h & 15];
+  hex[16] = '\0';
+  return lua_pushfstring(L, "%s" LUA_DIRSEP "%s.ljbc", dir, hex);
+}
+
+/* Load a cached dump. Returns 0 and pushes the function on success. */
+static int bccache_read(lua_State *L, const char *cname, const char *hdr,
+			const char *filename)
+{
+  BCCacheReader ctx;
+  size_t len = strlen(hdr);
+  int status;
+  ctx.fp = fopen(cname, "rb");
+  if (ctx.fp == NULL) return 1;
+  while (len > 0) {
+    size_t n = len < sizeof(ctx.buf) ? len : sizeof(ctx.buf);
+    if (fread(ctx.buf, 1, n, ctx.fp) != n || memcmp(ctx.buf, hdr, n)) {
+      fclose(ctx.fp);
+      return 1;
+    }
+    hdr += n;
+    len -= n;
+  }
+  lua_pushfstring(L, "@%s", filename);
+  status = lua_loadx(L, bccache_reader, &ctx, lua_tostring(L, -1), "b");
+  fclose(ctx.fp);
+  lua_remove(L, -2);
+  if (status != 0) {
+    lua_pop(L, 1);
+    return 1;
+  }
+  return 0;
+}
+
+/* Dump the function on top of the stack to the cache. Errors are ignored. */
+static void bccache_write(lua_State *L, const char *dir, const char *cname,
+			  const char *hdr)
+{
+  const char *tmp = lua_pushfstring(L, "%s.%d.tmp", cname, (int)getpid());
+  FILE *fp;
+  int fd, ok;
+  unlink(tmp);  /* Left over from a crashed process with the same pid. */
+  fd = open(tmp, O_WRONLY|O_CREAT|O_EXCL, 0644);
+  if (fd < 0 && errno == ENOENT && mkdir(dir, 0777) == 0)
+    fd = open(tmp, O_WRONLY|O_CREAT|O_EXCL, 0644);
+  if (fd < 0 || (fp = fdopen(fd, "wb")) == NULL) {
+    if (fd >= 0) { close(fd); unlink(tmp); }
+    lua_pop(L, 1);
+    return;
+  }
+  lua_pushvalue(L, -2);
+  ok = fputs(hdr, fp) >= 0 && lua_dump(L, bccache_writer, fp) == 0;
+  lua_pop(L, 1);
+  ok = (fclose(fp) == 0) && ok;
+  if (!(ok && rename(tmp, cname) == 0))
+    unlink(tmp);
+  lua_pop(L, 1);
+}
+
+static int bccache_loadfile(lua_State *L, const char *dir,
+			    const char *filename)
+{
+  struct stat st;
+  const char *hdr, *cname;
+  int base = lua_gettop(L), status;
+  if (stat(filename, &st) != 0 || !S_ISREG(st.st_mode))
+    return luaL_loadfile(L, filename);
+  hdr = bccache_header(L, filename, &st);
+  cname = bccache_name(L, dir, filename);
+  if (bccache_read(L, cname, hdr, filename) == 0) {
+    status = 0;
+  } else {
+    status = luaL_loadfile(L, filename);
+    if (status == 0) bccache_write(L, dir, cname, hdr);
+  }
+  lua_replace(L, base+1);
+  lua_settop(L, base+1);
+  return status;
+}
+
+#else
+
+#define bccache_loadfile(L, dir, filename)	luaL_loadfile((L), (filename))
+
+#endif
+
+/* -- Bundles ------------------------------------------------------------- */
+
+/*
+** A bundle holds many bytecode modules in one file, written by luajit -b -B.
+** All numbers are 32 bit little-endian:
+**
+** bundle = "\033LJB" versionW sizeW nslotsW slot* (name 0B | dump)*
+** slot   = hashW nameofsW dataofsW datalenW
+**
+** The slots form an open-addressed hash table with linear probing, indexed
+** by the FNV-1a hash of the module name. nslots is a power of two. Empty
+** slots have a zero nameofs. Offsets are relative to the start.
+*/
+
+#define BUNDLE_MAGIC		"\033LJB"
+#define BUNDLE_VERSION		1
+#define BUNDLE_HDR		16
+#define BUNDLE_SLOT		16
+#define BUNDLE_MT		"_BUNDLE"
+
+#define bundle_u32(p) \
+  ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+   ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+typedef struct PkgBundle {
+  const uint8_t *p;	/* Bundle data. */
+  size_t size;		/* Size of bundle data. */
+  size_t mapsz;		/* Size of the mapping or 0. */
+} PkgBundle;
+
+static uint32_t bundle_hash(const char *name)
+{
+  uint32_t h = 0x811c9dc5u;
+  while (*name) h = (h ^ (uint8_t)*name++) * 16777619u;
+  return h;
+}
+
+/* Check header and set the size of a bundle. Returns 0 if it's bad. */
+static int bundle_check(PkgBundle *b, size_t avail)
+{
+  const uint8_t *p = b->p;
+  uint32_t size, nslots;
+  if (avail < BUNDLE_HDR || memcmp(p, BUNDLE_MAGIC, 4) != 0 ||
+      bundle_u32(p+4) != BUNDLE_VERSION)
+    return 0;
+  size = bundle_u32(p+8);
+  nslots = bundle_u32(p+12);
+  if (size > avail || nslots == 0 || (nslots & (nslots-1)) != 0 ||
+      nslots > (size - BUNDLE_HDR) / BUNDLE_SLOT)
+    return 0;
+  b->size = size;
+  return 1;
+}
+
+/* Look up a module in a bundle. Returns its bytecode dump or NULL. */
+static const char *bundle_find(const PkgBundle *b, const char *name,
+			       size_t *len)
+{
+  const uint8_t *p = b->p;
+  uint32_t h = bundle_hash(name), mask = bundle_u32(p+12) - 1, i, n;
+  size_t nlen = strlen(name);
+  for (i = h & mask, n = 0; n <= mask; i = (i+1) & mask, n++) {
+    const uint8_t *e = p + BUNDLE_HDR + (size_t)i*BUNDLE_SLOT;
+    uint32_t nofs = bundle_u32(e+4);
+    if (nofs == 0) break;
+    if (bundle_u32(e) == h && nofs < b->size && nlen < b->size - nofs &&
+	memcmp(p + nofs, name, nlen+1) == 0) {
+      uint32_t dofs = bundle_u32(e+8), dlen = bundle_u32(e+12);
+      if (dofs > b->size || dlen > b->size - dofs) return NULL;
+      *len = dlen;
+      return (const char *)p + dofs;
+    }
+  }
+  return NULL;
+}
+
+/* Open a bundle file. Returns 0 and sets errno on failure. */
+static int bundle_open(lua_State *L, PkgBundle *b, const char *filename)
+{
+#if LJ_TARGET_POSIX
+  struct stat st;
+  void *p;
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) return 0;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+      (uint64_t)st.st_size > 0xffffffffu || st.st_size < BUNDLE_HDR) {
+    close(fd);
+    errno = EINVAL;
+    return 0;
+  }
+  p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return 0;
+  b->p = (const uint8_t *)p;
+  b->size = b->mapsz = (size_t)st.st_size;
+  UNUSED(L);
+  return 1;
+#else
+  FILE *fp = fopen(filename, "rb");
+  long sz;
+  void *q;
+  if (fp == NULL) return 0;
+  if (fseek(fp, 0, SEEK_END) != 0 || (sz = ftell(fp)) < 0 ||
+      fseek(fp, 0, SEEK_SET) != 0) {
+    fclose(fp);
+    return 0;
+  }
+  lua_createtable(L, 0, 1);  /* Anchor the data in the bundle env. */
+  q = lua_newuserdata(L, (size_t)sz);
+  lua_setfield(L, -2, "data");
+  lua_setfenv(L, -2);
+  if (fread(q, 1, (size_t)sz, fp) != (size_t)sz) {
+    fclose(fp);
+    return 0;
+  }
+  fclose(fp);
+  b->p = (const uint8_t *)q;
+  b->size = (size_t)sz;
+  return 1;
+#endif
+}
+
+static int lj_cf_package_bundle_gc(lua_State *L)
+{
+  PkgBundle *b = (PkgBundle *)luaL_checkudata(L, 1, BUNDLE_MT);
+#if LJ_TARGET_POSIX
+  if (b->mapsz) munmap((void *)b->p, b->mapsz);
+#endif
+  b->p = NULL;
+  b->mapsz = 0;
+  return 0;
+}
+
+static int lj_cf_package_loadbundle(lua_State *L)
+{
+  const char *name = luaL_checkstring(L, 1);
+  const char *bcdata = ll_bcsym(NULL, mksymname(L, name, SYMPREFIX_BC));
+  PkgBundle *b;
+  lua_pop(L, 1);
+  b = (PkgBundle *)lua_newuserdata(L, sizeof(PkgBundle));
+  b->p = NULL;
+  b->size = b->mapsz = 0;
+  luaL_getmetatable(L, BUNDLE_MT);
+  lua_setmetatable(L, -2);
+  if (bcdata && memcmp(bcdata, BUNDLE_MAGIC, 4) == 0) {  /* Embedded. */
+    b->p = (const uint8_t *)bcdata;
+    if (!bundle_check(b, ~(size_t)0)) goto bad;
+  } else {
+    if (!bundle_open(L, b, name)) {
+      lua_pushnil(L);
+      lua_pushfstring(L, "cannot open %s: %s", name, strerror(errno));
+      return 2;
+    }
+    if (!bundle_check(b, b->size)) goto bad;
+  }
+  lua_getfield(L, LUA_ENVIRONINDEX, "bundles");
+  if (!lua_istable(L, -1))
+    luaL_error(L, LUA_QL("package.bundles") " must be a table");
+  lua_pushvalue(L, -2);
+  lua_rawseti(L, -2, (int)lua_objlen(L, -2) + 1);
+  lua_pushboolean(L, 1);
+  return 1;
+bad:
+  lua_pushnil(L);
+  lua_pushfstring(L, "bad bundle %s", name);
+  return 2;
+}
+
+static int lj_cf_package_loader_bundle(lua_State *L)
+{
+  const char *name = luaL_checkstring(L, 1);
+  int i;
+  lua_getfield(L, LUA_ENVIRONINDEX, "bundles");
+  if (!lua_istable(L, -1))
+    luaL_error(L, LUA_QL("package.bundles") " must be a table");
+  for (i = 1; ; i++) {
+    PkgBundle *b;
+    const char *data;
+    size_t len;
+    lua_rawgeti(L, 2, i);
+    if (lua_isnil(L, -1)) break;
+    b = (PkgBundle *)luaL_checkudata(L, -1, BUNDLE_MT);
+    if (b->p && (data = bundle_find(b, name, &len)) != NULL) {
+      /* The bundle owns the dump, so inner functions may load lazily. */
+      GCobj *owner = obj2gco(udataV(L->top-1));
+      const char *chunkname = lua_pushfstring(L, "@%s", name);
+      if (lj_load_owned(L, owner, data, len, chunkname, "b") != 0)
+	luaL_error(L, "error loading module " LUA_QS " from bundle:\n\t%s",
+		   name, lua_tostring(L, -1));
+      return 1;
+    }
+    lua_pop(L, 1);
+  }
+  if (i == 1) return 0;  /* No bundles. */
+  lua_pushfstring(L, "\n\tno module " LUA_QS " in package.bundles", name);
+  return 1;
+}
+
 static int lj_cf_package_loader_lua(lua_State *L)
 {
-  const char *filename;
+  const char *filename, *dir;
   const char *name = luaL_checkstring(L, 1);
   filename = findfile(L, name, "path");
   if (filename == NULL) return 1;  /* library not found in this path */
-  if (luaL_loadfile(L, filename) != 0)
+  lua_getfield(L, LUA_ENVIRONINDEX, "bccache");
+  dir = lua_tostring(L, -1);
+  if ((dir && *dir ? bccache_loadfile(L, dir, filename) :
+		     luaL_loadfile(L, filename)) != 0)
     loaderror(L, filename);
   return 1;  /* library loaded successfully */
 }
@@ -418,7 +871,7 @@ static int lj_cf_package_loader_preload(lua_State *L)
   if (lua_isnil(L, -1)) {  /* Not found? */
     const char *bcname = mksymname(L, name, SYMPREFIX_BC);
     const char *bcdata = ll_bcsym(NULL, bcname);
-    if (bcdata == NULL || luaL_loadbuffer(L, bcdata, ~(size_t)0, name) != 0)
+    if (bcdata == NULL || ll_loadbc(L, bcdata, name) != 0)
       lua_pushfstring(L, "\n\tno field package.preload['%s']", name);
   }
   return 1;
@@ -588,6 +1041,7 @@ static const lua_CFunction package_loaders[] =
   lj_cf_package_loader_lua,
   lj_cf_package_loader_c,
   lj_cf_package_loader_croot,
+  lj_cf_package_loader_bundle,
   NULL
 };
 
@@ -598,6 +1052,10 @@ LUALIB_API int luaopen_package(lua_State *L)
   luaL_newmetatable(L, "_LOADLIB");
   lj_lib_pushcf(L, lj_cf_package_unloadlib, 1);
   lua_setfield(L, -2, "__gc");
+  luaL_newmetatable(L, BUNDLE_MT);
+  lj_lib_pushcf(L, lj_cf_package_bundle_gc, 1);
+  lua_setfield(L, -2, "__gc");
+  lua_pop(L, 1);
   luaL_register(L, LUA_LOADLIBNAME, package_lib);
   lua_copy(L, -1, LUA_ENVIRONINDEX);
   lua_createtable(L, sizeof(package_loaders)/sizeof(package_loaders[0])-1, 0);
@@ -615,12 +1073,22 @@ LUALIB_API int luaopen_package(lua_State *L)
   lua_pop(L, 1);
   setpath(L, "path", LUA_PATH, LUA_PATH_DEFAULT, noenv);
   setpath(L, "cpath", LUA_CPATH, LUA_CPATH_DEFAULT, noenv);
+#if !LJ_TARGET_CONSOLE
+  if (!noenv && getenv(LUA_BCCACHE)) {
+    lua_pushstring(L, getenv(LUA_BCCACHE));
+    lua_setfield(L, -2, "bccache");
+  }
+#endif
   lua_pushliteral(L, LUA_PATH_CONFIG);
   lua_setfield(L, -2, "config");
   luaL_findtable(L, LUA_REGISTRYINDEX, "_LOADED", 16);
   lua_setfield(L, -2, "loaded");
   luaL_findtable(L, LUA_REGISTRYINDEX, "_PRELOAD", 4);
   lua_setfield(L, -2, "preload");
+  lua_newtable(L);
+  lua_setfield(L, -2, "bundles");
+  lj_lib_pushcf(L, lj_cf_package_loadbundle, 1);  /* Needs package env. */
+  lua_setfield(L, -2, "loadbundle");
   lua_pushvalue(L, LUA_GLOBALSINDEX);
   luaL_register(L, NULL, package_global);
   lua_pop(L, 1);
@@ -123,10 +123,18 @@ static int writer_buf(lua_State *L, const void *p, size_t size, void *sb)
 LJLIB_CF(string_dump)
 {
   GCfunc *fn = lj_lib_checkfunc(L, 1);
-  int strip = L->base+1 < L->top && tvistruecond(L->base+1);
+  uint32_t flags = 0;
   SBuf *sb = lj_buf_tmp_(L);  /* Assumes lj_bcwrite() doesn't use tmpbuf. */
+  if (L->base+1 < L->top && tvisstr(L->base+1)) {
+    const char *mode = strVdata(L->base+1);
+    if (strchr(mode, 's')) flags |= BCDUMP_F_STRIP;
+    if (strchr(mode, 'l')) flags |= BCDUMP_F_LAZY;
+    if (!flags) flags = BCDUMP_F_STRIP;  /* Any other string is true. */
+  } else if (L->base+1 < L->top && tvistruecond(L->base+1)) {
+    flags = BCDUMP_F_STRIP;
+  }
   L->top = L->base+1;
-  if (!isluafunc(fn) || lj_bcwrite(L, funcproto(fn), writer_buf, sb, strip))
+  if (!isluafunc(fn) || lj_bcwrite(L, funcproto(fn), writer_buf, sb, flags))
     lj_err_caller(L, LJ_ERR_STRDUMP);
   setstrV(L, L->top-1, lj_buf_str(L, sb));
   lj_gc_check(L);
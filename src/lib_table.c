@@ -81,6 +81,8 @@ LJLIB_CF(table_insert)		LJLIB_REC(.)
   GCtab *t = lj_lib_checktab(L, 1);
   int32_t n, i = (int32_t)lj_tab_len(t) + 1;
   int nargs = (int)((char *)L->top - (char *)L->base);
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_caller(L, LJ_ERR_FROZEN);
   if (nargs != 2*sizeof(TValue)) {
     if (nargs != 3*sizeof(TValue))
       lj_err_caller(L, LJ_ERR_TABINS);
@@ -105,49 +107,49 @@ LJLIB_CF(table_insert)		LJLIB_REC(.)
   return 0;
 }
 
-LJLIB_LUA(table_remove) /*
-  function(t, pos)
-    CHECK_tab(t)
-    local len = #t
-    if pos == nil then
-      if len ~= 0 then
-	local old = t[len]
-	t[len] = nil
-	return old
-      end
-    else
-      CHECK_int(pos)
-      if pos >= 1 and pos <= len then
-	local old = t[pos]
-	for i=pos+1,len do
-	  t[i-1] = t[i]
-	end
-	t[len] = nil
-	return old
-      end
-    end
-  end
-*/
+LJLIB_CF(table_remove)		LJLIB_REC(.)
+{
+  GCtab *t = lj_lib_checktab(L, 1);
+  int32_t e = (int32_t)lj_tab_len(t);
+  int32_t pos = e;
+  if (L->base+1 < L->top && !tvisnil(L->base+1)) {
+    pos = lj_lib_checkint(L, 2);
+    if (pos < 1 || pos > e) return 0;
+  } else if (e == 0) {
+    return 0;
+  }
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_caller(L, LJ_ERR_FROZEN);
+  {
+    cTValue *old = lj_tab_getint(t, pos);
+    if (old) {
+      copyTV(L, L->top++, old);  /* Return old value. */
+    } else {
+      setnilV(L->top++);
+    }
+  }
+  /* NOBARRIER: This just moves existing elements around. */
+  lj_tab_move(L, t, pos+1, e, pos, t);
+  setnilV(lj_tab_setint(L, t, e));
+  return 1;
+}
 
-LJLIB_LUA(table_move) /*
-  function(a1, f, e, t, a2)
-    CHECK_tab(a1)
-    CHECK_int(f)
-    CHECK_int(e)
-    CHECK_int(t)
-    if a2 == nil then a2 = a1 end
-    CHECK_tab(a2)
-    if e >= f then
-      local d = t - f
-      if t > e or t <= f or a2 ~= a1 then
-	for i=f,e do a2[i+d] = a1[i] end
-      else
-	for i=e,f,-1 do a2[i+d] = a1[i] end
-      end
-    end
-    return a2
-  end
-*/
+LJLIB_CF(table_move)		LJLIB_REC(.)
+{
+  GCtab *a1 = lj_lib_checktab(L, 1);
+  int32_t f = lj_lib_checkint(L, 2);
+  int32_t e = lj_lib_checkint(L, 3);
+  int32_t t = lj_lib_checkint(L, 4);
+  GCtab *a2 = (L->base+4 < L->top && !tvisnil(L->base+4)) ?
+	      lj_lib_checktab(L, 5) : a1;
+  if (e >= f) {
+    if (LJ_UNLIKELY(isfrozen(obj2gco(a2))))
+      lj_err_caller(L, LJ_ERR_FROZEN);
+    lj_tab_move(L, a1, f, e, t, a2);
+  }
+  settabV(L, L->top++, a2);
+  return 1;
+}
 
 LJLIB_CF(table_concat)		LJLIB_REC(.)
 {
@@ -295,10 +297,21 @@ LJLIB_NOREG LJLIB_CF(table_new)		LJLIB_REC(.)
 
 LJLIB_NOREG LJLIB_CF(table_clear)	LJLIB_REC(.)
 {
-  lj_tab_clear(lj_lib_checktab(L, 1));
+  GCtab *t = lj_lib_checktab(L, 1);
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_caller(L, LJ_ERR_FROZEN);
+  lj_tab_clear(t);
   return 0;
 }
 
+LJLIB_NOREG LJLIB_CF(table_freeze)
+{
+  GCtab *t = lj_lib_checktab(L, 1);
+  lj_gc_freeze(L, t);
+  settabV(L, L->top++, t);
+  return 1;
+}
+
 static int luaopen_table_new(lua_State *L)
 {
   return lj_lib_postreg(L, lj_cf_table_new, FF_table_new, "new");
@@ -309,6 +322,11 @@ static int luaopen_table_clear(lua_State *L)
   return lj_lib_postreg(L, lj_cf_table_clear, FF_table_clear, "clear");
 }
 
+static int luaopen_table_freeze(lua_State *L)
+{
+  return lj_lib_postreg(L, lj_cf_table_freeze, FF_table_freeze, "freeze");
+}
+
 /* ------------------------------------------------------------------------ */
 
 #include "lj_libdef.h"
@@ -322,6 +340,8 @@ LUALIB_API int luaopen_table(lua_State *L)
 #endif
   lj_lib_prereg(L, LUA_TABLIBNAME ".new", luaopen_table_new, tabV(L->top-1));
   lj_lib_prereg(L, LUA_TABLIBNAME ".clear", luaopen_table_clear, tabV(L->top-1));
+  lj_lib_prereg(L, LUA_TABLIBNAME ".freeze", luaopen_table_freeze,
+		tabV(L->top-1));
   return 1;
 }
 
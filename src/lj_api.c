@@ -1005,6 +1005,8 @@ LUA_API void lua_rawset(lua_State *L, int idx)
   TValue *dst, *key;
   lj_checkapi_slot(2);
   key = L->top-2;
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_msg(L, LJ_ERR_FROZEN);
   dst = lj_tab_set(L, t, key);
   copyTV(L, dst, key+1);
   lj_gc_anybarriert(L, t);
@@ -1016,6 +1018,8 @@ LUA_API void lua_rawseti(lua_State *L, int idx, int n)
   GCtab *t = tabV(index2adr(L, idx));
   TValue *dst, *src;
   lj_checkapi_slot(1);
+  if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+    lj_err_msg(L, LJ_ERR_FROZEN);
   dst = lj_tab_setint(L, t, n);
   src = L->top-1;
   copyTV(L, dst, src);
@@ -1037,6 +1041,8 @@ LUA_API int lua_setmetatable(lua_State *L, int idx)
   }
   g = G(L);
   if (tvistab(o)) {
+    if (LJ_UNLIKELY(isfrozen(obj2gco(tabV(o)))))
+      lj_err_msg(L, LJ_ERR_FROZEN);
     setgcref(tabV(o)->metatable, obj2gco(mt));
     if (mt)
       lj_gc_objbarriert(L, tabV(o), mt);
@@ -1061,6 +1067,13 @@ LUA_API int lua_setmetatable(lua_State *L, int idx)
   return 1;
 }
 
+LUA_API void luaJIT_freeze(lua_State *L, int idx)
+{
+  cTValue *o = index2adr_check(L, idx);
+  lj_checkapi(tvistab(o), "stack slot %d is not a table", idx);
+  lj_gc_freeze(L, tabV(o));
+}
+
 LUALIB_API void luaL_setmetatable(lua_State *L, const char *tname)
 {
   lua_getfield(L, LUA_REGISTRYINDEX, tname);
@@ -147,6 +147,34 @@ static IRRef asm_fuseabase(ASMState *as, IRRef ref)
   return ref;  /* Otherwise use the given array base. */
 }
 
+/* Fuse colocated hash part base into an offset to the table object. */
+static IRRef asm_fusehbase(ASMState *as, IRRef ref, int32_t *ofs)
+{
+  IRIns *irb = IR(ref);
+  IRIns *ira;
+  uint32_t asize, hbits;
+  lj_assertA(irb->o == IR_FLOAD && irb->op2 == IRFL_TAB_NODE,
+	     "expected FLOAD TAB_NODE");
+  ira = IR(irb->op1);
+  if (ira->o == IR_TNEW) {
+    asize = ira->op1;
+    hbits = ira->op2;
+  } else if (ira->o == IR_TDUP) {
+    GCtab *kt = ir_ktab(IR(ira->op1));
+    asize = kt->asize;
+    hbits = kt->hmask > 0 ? lj_fls(kt->hmask)+1 : 0;
+  } else {
+    return ref;
+  }
+  /* We can avoid the FLOAD of t->node for colocated hash parts. */
+  if (hbits > 0 && hbits <= LJ_MAX_COLOHBITS &&
+      !neverfuse(as) && noconflict(as, irb->op1, IR_NEWREF, 1)) {
+    *ofs += (int32_t)sizetabcolo(asize <= LJ_MAX_COLOSIZE ? asize : 0);
+    return irb->op1;  /* Table obj. */
+  }
+  return ref;  /* Otherwise use the loaded hash part base. */
+}
+
 /* Fuse array reference into memory operand. */
 static void asm_fusearef(ASMState *as, IRIns *ir, RegSet allow)
 {
@@ -192,8 +220,9 @@ static void asm_fuseahuref(ASMState *as, IRRef ref, RegSet allow)
       break;
     case IR_HREFK:
       if (mayfuse(as, ref)) {
-	as->mrm.base = (uint8_t)ra_alloc1(as, ir->op1, allow);
 	as->mrm.ofs = (int32_t)(IR(ir->op2)->op2 * sizeof(Node));
+	as->mrm.base = (uint8_t)ra_alloc1(as,
+			 asm_fusehbase(as, ir->op1, &as->mrm.ofs), allow);
 	as->mrm.idx = RID_NONE;
 	return;
       }
@@ -1299,11 +1328,12 @@ static void asm_hrefk(ASMState *as, IRIns *ir)
   IRIns *irkey = IR(kslot->op1);
   int32_t ofs = (int32_t)(kslot->op2 * sizeof(Node));
   Reg dest = ra_used(ir) ? ra_dest(as, ir, RSET_GPR) : RID_NONE;
-  Reg node = ra_alloc1(as, ir->op1, RSET_GPR);
+  Reg node;
 #if !LJ_64
   MCLabel l_exit;
 #endif
   lj_assertA(ofs % sizeof(Node) == 0, "unaligned HREFK slot");
+  node = ra_alloc1(as, asm_fusehbase(as, ir->op1, &ofs), RSET_GPR);
   if (ra_hasreg(dest)) {
     if (ofs != 0) {
       if (dest == node)
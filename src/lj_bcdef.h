@@ -0,0 +1,220 @@
+/* This is a generated file. DO NOT EDIT! */
+
+LJ_DATADEF const uint16_t lj_bc_ofs[] = {
+0,
+92,
+184,
+276,
+368,
+518,
+671,
+751,
+831,
+909,
+987,
+1047,
+1106,
+1162,
+1218,
+1267,
+1316,
+1351,
+1388,
+1415,
+1465,
+1522,
+1613,
+1672,
+1731,
+1790,
+1849,
+1913,
+1972,
+2031,
+2090,
+2149,
+2189,
+2265,
+2341,
+2417,
+2493,
+2550,
+2641,
+2725,
+2768,
+2811,
+2842,
+2872,
+2902,
+2953,
+3001,
+3113,
+3217,
+3267,
+3317,
+3376,
+3461,
+3583,
+3689,
+3717,
+3745,
+3910,
+4056,
+4161,
+4226,
+4431,
+4703,
+4848,
+5010,
+5115,
+5179,
+5240,
+5243,
+5433,
+5518,
+5695,
+5904,
+6047,
+6050,
+6200,
+6307,
+6428,
+6543,
+6666,
+6686,
+6761,
+6832,
+6852,
+6896,
+6934,
+6954,
+6973,
+7023,
+7050,
+7070,
+7138,
+7196,
+7196,
+7331,
+7332,
+7442,
+9587,
+9662,
+10294,
+10393,
+10491,
+10656,
+9733,
+9917,
+10052,
+10125,
+10167,
+10754,
+10818,
+11579,
+10872,
+11259,
+11627,
+11790,
+11818,
+11672,
+11895,
+11941,
+11987,
+12033,
+12079,
+12125,
+12171,
+12217,
+12263,
+12309,
+12355,
+12673,
+12749,
+11849,
+12470,
+12401,
+12539,
+12608,
+12813,
+12890,
+13668,
+14104,
+14047,
+14176,
+14264,
+14355,
+14446,
+14537,
+13726,
+13833,
+13940,
+12967,
+13031,
+13165,
+13344,
+13452,
+13560
+};
+
+LJ_DATADEF const uint16_t lj_bc_mode[] = {
+BCDEF(BCMODE)
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF,
+BCMODE_FF
+};
+
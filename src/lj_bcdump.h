@@ -15,7 +15,7 @@
 /*
 ** dump   = header proto+ 0U
 ** header = ESC 'L' 'J' versionB flagsU [namelenU nameB*]
-** proto  = lengthU pdata
+** proto  = lengthU [numchildU] pdata
 ** pdata  = phead bcinsW* uvdataH* kgc* knum* [debugB*]
 ** phead  = flagsB numparamsB framesizeB numuvB numkgcU numknU numbcU
 **          [debuglenU [firstlineU numlineU]]
@@ -24,9 +24,12 @@
 ** ktab   = narrayU nhashU karray* khash*
 ** karray = ktabk
 ** khash  = ktabk ktabk
-** ktabk  = ktabtypeU { intU | (loU hiU) | strB* }
+** ktabk  = ktabtypeU { intU | (loU hiU) | strB* | ktab }
 **
 ** B = 8 bit, H = 16 bit, W = 32 bit, U = ULEB128 of W, U0/U1 = ULEB128 of W+1
+**
+** With BCDUMP_F_LAZY, each proto carries the number of child prototypes it
+** consumes. This allows a reader to skip over the pdata of inner functions.
 */
 
 /* Bytecode dump header. */
@@ -44,8 +47,10 @@
 #define BCDUMP_F_STRIP		0x02
 #define BCDUMP_F_FFI		0x04
 #define BCDUMP_F_FR2		0x08
+#define BCDUMP_F_KTAB		0x10
+#define BCDUMP_F_LAZY		0x20
 
-#define BCDUMP_F_KNOWN		(BCDUMP_F_FR2*2-1)
+#define BCDUMP_F_KNOWN		(BCDUMP_F_LAZY*2-1)
 
 /* Type codes for the GC constants of a prototype. Plus length for strings. */
 enum {
@@ -59,11 +64,30 @@ enum {
   BCDUMP_KTAB_INT, BCDUMP_KTAB_NUM, BCDUMP_KTAB_STR
 };
 
+/* With BCDUMP_F_KTAB, values may be nested template tables. These take the
+** type code of BCDUMP_KTAB_STR and the type codes for strings start one higher.
+*/
+#define BCDUMP_KTAB_TAB		BCDUMP_KTAB_STR
+
+/* Stub for a lazily loaded prototype. Followed by the collectable constants:
+** the owner of the dump data and the child prototypes.
+*/
+typedef struct BCLazy {
+  GCproto pt;		/* Stub prototype, see proto_islazy(). */
+  const char *p;	/* Start of pdata, kept alive by the owner. */
+  MSize len;		/* Length of pdata. */
+  uint32_t flags;	/* Flags of the bytecode dump. */
+  MSize slot;		/* Index of the stub in the constants of the parent. */
+} BCLazy;
+
 /* -- Bytecode reader/writer ---------------------------------------------- */
 
 LJ_FUNC int lj_bcwrite(lua_State *L, GCproto *pt, lua_Writer writer,
-		       void *data, int strip);
+		       void *data, uint32_t flags);
 LJ_FUNC GCproto *lj_bcread_proto(LexState *ls);
 LJ_FUNC GCproto *lj_bcread(LexState *ls);
+LJ_FUNC GCproto *lj_bcread_lazy(lua_State *L, GCproto *parent, GCproto *pt);
+LJ_FUNC int lj_load_owned(lua_State *L, GCobj *owner, const char *buf,
+			  size_t size, const char *name, const char *mode);
 
 #endif
\ No newline at end of file
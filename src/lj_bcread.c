@@ -179,14 +179,19 @@ static const void *bcread_varinfo(GCproto *pt)
   return p;
 }
 
+static GCtab *bcread_ktab(LexState *ls);
+
 /* Read a single constant key/value of a template table. */
 static void bcread_ktabk(LexState *ls, TValue *o)
 {
   MSize tp = bcread_uleb128(ls);
-  if (tp >= BCDUMP_KTAB_STR) {
-    MSize len = tp - BCDUMP_KTAB_STR;
+  MSize kstr = BCDUMP_KTAB_STR + !!(bcread_flags(ls) & BCDUMP_F_KTAB);
+  if (tp >= kstr) {
+    MSize len = tp - kstr;
     const char *p = (const char *)bcread_mem(ls, len);
     setstrV(ls->L, o, lj_str_new(ls->L, p, len));
+  } else if (tp == BCDUMP_KTAB_TAB) {
+    settabV(ls->L, o, bcread_ktab(ls));
   } else if (tp == BCDUMP_KTAB_INT) {
     setintV(o, (int32_t)bcread_uleb128(ls));
   } else if (tp == BCDUMP_KTAB_NUM) {
@@ -257,6 +262,8 @@ static void bcread_kgc(LexState *ls, GCproto *pt, MSize sizekgc)
 	bcread_error(ls, LJ_ERR_BCBAD);
       L->top--;
       setgcref(*kr, obj2gco(protoV(L->top)));
+      if (proto_islazy(protoV(L->top)))  /* Remember slot for patching. */
+	((BCLazy *)protoV(L->top))->slot = i;
     }
   }
 }
@@ -386,6 +393,78 @@ GCproto *lj_bcread_proto(LexState *ls)
   return pt;
 }
 
+/* -- Lazy prototypes ----------------------------------------------------- */
+
+/* Create a stub for a prototype and skip its pdata. */
+static GCproto *bcread_stub(LexState *ls, MSize len, MSize nchild)
+{
+  lua_State *L = ls->L;
+  MSize i, sizept = (MSize)sizeof(BCLazy) + (nchild+1)*(MSize)sizeof(GCRef);
+  BCLazy *lz = (BCLazy *)lj_mem_newgco(L, sizept);
+  GCproto *pt = &lz->pt;
+  GCRef *kr;
+  pt->gct = ~LJ_TPROTO;
+  pt->numparams = 0;
+  pt->framesize = 0;
+  pt->sizebc = 0;  /* Marks a stub. */
+  setmref(pt->k, (char *)pt + sizept);
+  setmref(pt->uv, NULL);
+  pt->sizekn = 0;
+  pt->sizept = sizept;
+  pt->sizeuv = 0;
+  pt->flags = nchild ? PROTO_CHILD : 0;
+  pt->trace = 0;
+  setgcref(pt->chunkname, obj2gco(ls->chunkname));
+  pt->firstline = 0;
+  pt->numline = 0;
+  setmref(pt->lineinfo, NULL);
+  setmref(pt->uvinfo, NULL);
+  setmref(pt->varinfo, NULL);
+  lz->p = ls->p;
+  lz->len = len;
+  lz->flags = bcread_flags(ls);
+  lz->slot = 0;
+  kr = mref(pt->k, GCRef) - (nchild+1);
+  setgcref(kr[0], ls->owner);
+  L->top -= nchild;
+  for (i = 0; i < nchild; i++)
+    setgcref(kr[i+1], obj2gco(protoV(L->top+i)));
+  pt->sizekgc = nchild+1;
+  ls->p += len;
+  return pt;
+}
+
+/* Materialize a stub prototype and patch the constant of its parent. */
+GCproto *lj_bcread_lazy(lua_State *L, GCproto *parent, GCproto *pt)
+{
+  BCLazy *lz = (BCLazy *)pt;
+  GCRef *kr = mref(pt->k, GCRef) - pt->sizekgc;
+  MSize i, nchild = pt->sizekgc-1;
+  GCproto *npt;
+  LexState lsd, *ls = &lsd;
+  ls->L = L;
+  ls->p = lz->p;
+  ls->pe = lz->p + lz->len;
+  ls->chunkname = proto_chunkname(pt);
+  ls->chunkarg = strdata(ls->chunkname);
+  bcread_flags(ls) = lz->flags;
+  lj_state_checkstack(L, nchild);
+  bcread_savetop(L, ls, L->top);
+  for (i = 0; i < nchild; i++, L->top++)  /* Restore children in order. */
+    setprotoV(L, L->top, gco2pt(gcref(kr[i+1])));
+  npt = lj_bcread_proto(ls);
+  if (ls->p != ls->pe || L->top != bcread_oldtop(L, ls))
+    bcread_error(ls, LJ_ERR_BCBAD);
+  npt->flags |= (pt->flags & PROTO_NOJIT);
+  kr = mref(parent->k, GCRef) - parent->sizekgc + lz->slot;
+  lj_assertL(gcref(*kr) == obj2gco(pt), "bad parent of lazy prototype");
+  setgcref(*kr, obj2gco(npt));
+  lj_gc_objbarrier(L, parent, npt);
+  return npt;
+}
+
+/* -- Bytecode dump ------------------------------------------------------- */
+
 /* Read and check header of bytecode dump. */
 static int bcread_header(LexState *ls)
 {
@@ -427,7 +506,7 @@ GCproto *lj_bcread(LexState *ls)
     bcread_error(ls, LJ_ERR_BCFMT);
   for (;;) {  /* Process all prototypes in the bytecode dump. */
     GCproto *pt;
-    MSize len;
+    MSize len, nchild = 0;
     const char *startp;
     /* Read length. */
     if (ls->p < ls->pe && ls->p[0] == 0) {  /* Shortcut EOF. */
@@ -437,11 +516,24 @@ GCproto *lj_bcread(LexState *ls)
     bcread_want(ls, 5);
     len = bcread_uleb128(ls);
     if (!len) break;  /* EOF */
+    if ((bcread_flags(ls) & BCDUMP_F_LAZY)) {
+      bcread_want(ls, 5);
+      nchild = bcread_uleb128(ls);
+      if (nchild > (MSize)(L->top - bcread_oldtop(L, ls)))
+	bcread_error(ls, LJ_ERR_BCBAD);
+    }
     bcread_need(ls, len);
     startp = ls->p;
-    pt = lj_bcread_proto(ls);
-    if (ls->p != startp + len)
-      bcread_error(ls, LJ_ERR_BCBAD);
+    /* Inner prototypes in the (uncopied) persistent buffer are lazy. */
+    if ((bcread_flags(ls) & BCDUMP_F_LAZY) && ls->owner &&
+	!(startp >= ls->sb.b && startp < ls->sb.e) &&
+	startp + len < ls->pe && startp[len] != 0) {
+      pt = bcread_stub(ls, len, nchild);
+    } else {
+      pt = lj_bcread_proto(ls);
+      if (ls->p != startp + len)
+	bcread_error(ls, LJ_ERR_BCBAD);
+    }
     setprotoV(L, L->top, pt);
     incr_top(L);
   }
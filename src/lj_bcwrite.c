@@ -30,6 +30,8 @@ typedef struct BCWriteCtx {
   void *wdata;			/* Writer callback data. */
   int strip;			/* Strip debug info. */
   int status;			/* Status from writer callback. */
+  int ktab;			/* Has nested template tables. */
+  int lazy;			/* Write child counts for lazy loading. */
 #ifdef LUA_USE_ASSERT
   global_State *g;
 #endif
@@ -43,6 +45,8 @@ typedef struct BCWriteCtx {
 
 /* -- Bytecode writer ----------------------------------------------------- */
 
+static void bcwrite_ktab(BCWriteCtx *ctx, char *p, const GCtab *t);
+
 /* Write a single constant key/value of a template table. */
 static void bcwrite_ktabk(BCWriteCtx *ctx, cTValue *o, int narrow)
 {
@@ -51,8 +55,13 @@ static void bcwrite_ktabk(BCWriteCtx *ctx, cTValue *o, int narrow)
     const GCstr *str = strV(o);
     MSize len = str->len;
     p = lj_buf_more(&ctx->sb, 5+len);
-    p = lj_strfmt_wuleb128(p, BCDUMP_KTAB_STR+len);
+    p = lj_strfmt_wuleb128(p, BCDUMP_KTAB_STR+ctx->ktab+len);
     p = lj_buf_wmem(p, strdata(str), len);
+  } else if (tvistab(o)) {
+    lj_assertBCW(ctx->ktab, "unexpected nested template table");
+    *p++ = BCDUMP_KTAB_TAB;
+    bcwrite_ktab(ctx, p, tabV(o));
+    return;
   } else if (tvisint(o)) {
     *p++ = BCDUMP_KTAB_INT;
     p = lj_strfmt_wuleb128(p, intV(o));
@@ -117,6 +126,33 @@ static void bcwrite_ktab(BCWriteCtx *ctx, char *p, const GCtab *t)
   }
 }
 
+/* Check for nested template tables in a prototype and its children. */
+static int bcwrite_hasktab(GCproto *pt)
+{
+  MSize i, sizekgc = pt->sizekgc;
+  GCRef *kr = mref(pt->k, GCRef) - (ptrdiff_t)sizekgc;
+  if (proto_islazy(pt))  /* Don't materialize stubs just for this check. */
+    return (((BCLazy *)pt)->flags & BCDUMP_F_KTAB) != 0;
+  for (i = 0; i < sizekgc; i++, kr++) {
+    GCobj *o = gcref(*kr);
+    if (o->gch.gct == ~LJ_TPROTO) {
+      if (bcwrite_hasktab(gco2pt(o))) return 1;
+    } else if (o->gch.gct == ~LJ_TTAB) {
+      GCtab *t = gco2tab(o);
+      TValue *array = tvref(t->array);
+      Node *node = noderef(t->node);
+      MSize j;
+      for (j = 0; j < t->asize; j++)
+	if (tvistab(&array[j])) return 1;
+      if (t->hmask > 0) {
+	for (j = 0; j <= t->hmask; j++)
+	  if (tvistab(&node[j].val)) return 1;
+      }
+    }
+  }
+  return 0;
+}
+
 /* Write GC constants of a prototype. */
 static void bcwrite_kgc(BCWriteCtx *ctx, GCproto *pt)
 {
@@ -242,7 +278,7 @@ static char *bcwrite_bytecode(BCWriteCtx *ctx, char *p, GCproto *pt)
 /* Write prototype. */
 static void bcwrite_proto(BCWriteCtx *ctx, GCproto *pt)
 {
-  MSize sizedbg = 0;
+  MSize sizedbg = 0, nchild = 0;
   char *p;
 
   /* Recursively write children of prototype. */
@@ -251,15 +287,20 @@ static void bcwrite_proto(BCWriteCtx *ctx, GCproto *pt)
     GCRef *kr = mref(pt->k, GCRef) - 1;
     for (i = 0; i < n; i++, kr--) {
       GCobj *o = gcref(*kr);
-      if (o->gch.gct == ~LJ_TPROTO)
-	bcwrite_proto(ctx, gco2pt(o));
+      if (o->gch.gct == ~LJ_TPROTO) {
+	GCproto *cpt = gco2pt(o);
+	if (proto_islazy(cpt))
+	  cpt = lj_bcread_lazy(sbufL(&ctx->sb), pt, cpt);
+	bcwrite_proto(ctx, cpt);
+	nchild++;
+      }
     }
   }
 
   /* Start writing the prototype info to a buffer. */
   p = lj_buf_need(&ctx->sb,
-		  5+4+6*5+(pt->sizebc-1)*(MSize)sizeof(BCIns)+pt->sizeuv*2);
-  p += 5;  /* Leave room for final size. */
+		  10+4+6*5+(pt->sizebc-1)*(MSize)sizeof(BCIns)+pt->sizeuv*2);
+  p += 10;  /* Leave room for final size and child count. */
 
   /* Write prototype header. */
   *p++ = (pt->flags & (PROTO_CHILD|PROTO_VARARG|PROTO_FFI));
@@ -297,11 +338,14 @@ static void bcwrite_proto(BCWriteCtx *ctx, GCproto *pt)
 
   /* Pass buffer to writer function. */
   if (ctx->status == 0) {
-    MSize n = sbuflen(&ctx->sb) - 5;
+    MSize n = sbuflen(&ctx->sb) - 10;
     MSize nn = (lj_fls(n)+8)*9 >> 6;
-    char *q = ctx->sb.b + (5 - nn);
+    char *q;
+    if (ctx->lazy) nn += (lj_fls(nchild|1)+8)*9 >> 6;
+    q = ctx->sb.b + (10 - nn);
     p = lj_strfmt_wuleb128(q, n);  /* Fill in final size. */
-    lj_assertBCW(p == ctx->sb.b + 5, "bad ULEB128 write");
+    if (ctx->lazy) p = lj_strfmt_wuleb128(p, nchild);
+    lj_assertBCW(p == ctx->sb.b + 10, "bad ULEB128 write");
     ctx->status = ctx->wfunc(sbufL(&ctx->sb), q, nn+n, ctx->wdata);
   }
 }
@@ -318,9 +362,11 @@ static void bcwrite_header(BCWriteCtx *ctx)
   *p++ = BCDUMP_HEAD3;
   *p++ = BCDUMP_VERSION;
   *p++ = (ctx->strip ? BCDUMP_F_STRIP : 0) +
+	 (ctx->lazy ? BCDUMP_F_LAZY : 0) +
 	 LJ_BE*BCDUMP_F_BE +
 	 ((ctx->pt->flags & PROTO_FFI) ? BCDUMP_F_FFI : 0) +
-	 LJ_FR2*BCDUMP_F_FR2;
+	 LJ_FR2*BCDUMP_F_FR2 +
+	 (ctx->ktab ? BCDUMP_F_KTAB : 0);
   if (!ctx->strip) {
     p = lj_strfmt_wuleb128(p, len);
     p = lj_buf_wmem(p, name, len);
@@ -350,17 +396,19 @@ static TValue *cpwriter(lua_State *L, lua_CFunction dummy, void *ud)
   return NULL;
 }
 
-/* Write bytecode for a prototype. */
+/* Write bytecode for a prototype. Flags: BCDUMP_F_STRIP, BCDUMP_F_LAZY. */
 int lj_bcwrite(lua_State *L, GCproto *pt, lua_Writer writer, void *data,
-	      int strip)
+	      uint32_t flags)
 {
   BCWriteCtx ctx;
   int status;
   ctx.pt = pt;
   ctx.wfunc = writer;
   ctx.wdata = data;
-  ctx.strip = strip;
+  ctx.strip = (flags & BCDUMP_F_STRIP) != 0;
+  ctx.lazy = (flags & BCDUMP_F_LAZY) != 0;
   ctx.status = 0;
+  ctx.ktab = bcwrite_hasktab(pt);
 #ifdef LUA_USE_ASSERT
   ctx.g = G(L);
 #endif
@@ -15,6 +15,92 @@
 #include "lj_tab.h"
 #include "lj_strfmt.h"
 
+#if LJ_TARGET_POSIX
+#include <sys/mman.h>
+#endif
+
+/* -- Buffer storage pool ------------------------------------------------- */
+
+/* Size class of buffer storage or -1 if it's not poolable. */
+static LJ_AINLINE int bufpool_class(MSize sz)
+{
+  if (sz < LJ_MIN_SBUF || sz > LJ_MAX_POOLSBUF || (sz & (sz-1)))
+    return -1;
+  return (int)(lj_fls(sz) - lj_fls(LJ_MIN_SBUF));
+}
+
+/* Get storage from the pool. Returns NULL if the free list is empty. */
+static char *bufpool_get(global_State *g, MSize sz)
+{
+  SBufPool *bp = &g->bufpool;
+  int c = bufpool_class(sz);
+  char *b;
+  if (c < 0) return NULL;
+  b = mref(bp->list[c], char);
+  if (b) {
+    setmref(bp->list[c], *(char **)b);
+    bp->retained -= sz;
+    if (--bp->num[c] < bp->low[c]) bp->low[c] = bp->num[c];
+    bp->hits++;
+  } else {
+    bp->misses++;
+  }
+  return b;
+}
+
+/* Return storage to the pool, unless it's too big or the pool is full. */
+void lj_buf_pool_put(global_State *g, char *b, MSize sz)
+{
+  SBufPool *bp = &g->bufpool;
+  int c = bufpool_class(sz);
+  if (c >= 0 && bp->retained + sz <= bp->limit) {
+    *(char **)b = mref(bp->list[c], char);
+    setmref(bp->list[c], b);
+    bp->num[c]++;
+    bp->retained += sz;
+  } else {
+    lj_mem_free(g, b, sz);
+  }
+}
+
+/* Free n blocks of a size class. */
+static void bufpool_release(global_State *g, int c, uint32_t n)
+{
+  SBufPool *bp = &g->bufpool;
+  MSize sz = (MSize)LJ_MIN_SBUF << c;
+  for (; n > 0; n--) {
+    char *b = mref(bp->list[c], char);
+    setmref(bp->list[c], *(char **)b);
+    bp->num[c]--;
+    bp->retained -= sz;
+    lj_mem_free(g, b, sz);
+  }
+}
+
+/* Free half of the storage that stayed unused since the last GC cycle.
+** The pool shrinks back gradually after a load spike.
+*/
+void lj_buf_pool_trim(global_State *g)
+{
+  SBufPool *bp = &g->bufpool;
+  int c;
+  for (c = 0; c < SBUFPOOL_NCLASS; c++) {
+    bufpool_release(g, c, bp->low[c] - (bp->low[c] >> 1));
+    bp->low[c] = bp->num[c];
+  }
+}
+
+/* Free all pooled storage. */
+void lj_buf_pool_free(global_State *g)
+{
+  SBufPool *bp = &g->bufpool;
+  int c;
+  for (c = 0; c < SBUFPOOL_NCLASS; c++) {
+    bufpool_release(g, c, bp->num[c]);
+    bp->low[c] = 0;
+  }
+}
+
 /* -- Buffer management --------------------------------------------------- */
 
 static void buf_grow(SBuf *sb, MSize sz)
@@ -22,15 +108,26 @@ static void buf_grow(SBuf *sb, MSize sz)
   MSize osz = sbufsz(sb), len = sbuflen(sb), nsz = osz;
   char *b;
   GCSize flag;
+  int pool;
   if (nsz < LJ_MIN_SBUF) nsz = LJ_MIN_SBUF;
   while (nsz < sz) nsz += nsz;
   flag = sbufflag(sb);
+  /* The storage of buffer objects is pooled. Round up to a size class. */
+  pool = (flag & (SBUF_FLAG_EXT|SBUF_FLAG_BORROW)) == SBUF_FLAG_EXT &&
+	 nsz <= LJ_MAX_POOLSBUF;
+  if (pool && (nsz & (nsz-1))) nsz = 2u << lj_fls(nsz);
   if ((flag & SBUF_FLAG_COW)) {  /* Copy-on-write semantics. */
+    int ismap = sbufismap(sbufX(sb));
     lj_assertG_(G(sbufL(sb)), sb->w == sb->e, "bad SBuf COW");
-    b = (char *)lj_mem_new(sbufL(sb), nsz);
+    b = pool ? bufpool_get(G(sbufL(sb)), nsz) : NULL;
+    if (!b) b = (char *)lj_mem_new(sbufL(sb), nsz);
+    memcpy(b, sb->b, osz);
+    if (ismap) lj_bufx_unmap(sbufX(sb));
     setsbufflag(sb, flag & ~(GCSize)SBUF_FLAG_COW);
     setgcrefnull(sbufX(sb)->cowref);
-    memcpy(b, sb->b, osz);
+  } else if (pool && (b = bufpool_get(G(sbufL(sb)), nsz)) != NULL) {
+    memcpy(b, sb->b, len);
+    lj_buf_pool_put(G(sbufL(sb)), sb->b, osz);
   } else {
     b = (char *)lj_mem_realloc(sbufL(sb), sb->b, osz, nsz);
   }
@@ -109,6 +206,16 @@ char * LJ_FASTCALL lj_buf_tmp(lua_State *L, MSize sz)
   return lj_buf_need(sb, sz);
 }
 
+/* Release the file mapping of a buffer. */
+void LJ_FASTCALL lj_bufx_unmap(SBufExt *sbx)
+{
+#if LJ_TARGET_POSIX
+  munmap(sbx->b, sbufsz(sbx));
+#else
+  UNUSED(sbx);
+#endif
+}
+
 #if LJ_HASBUFFER && LJ_HASJIT
 void lj_bufx_set(SBufExt *sbx, const char *p, MSize len, GCobj *ref)
 {
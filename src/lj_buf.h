@@ -30,6 +30,18 @@ typedef struct SBufExt {
   GCRef dict_str;	/* Serialization string dictionary table. */
   GCRef dict_mt;	/* Serialization metatable dictionary table. */
   int depth;		/* Remaining recursion depth. */
+  uint32_t sopt;	/* Serialization options. */
+  GCRef shapes;		/* Shapes of the current object. Not marked by GC. */
+  uint32_t nshapes;	/* Number of shapes. */
+  uint32_t lastshape;	/* Last shape used by the encoder. */
+  GCRef refs;		/* Tables of the current object. Not marked by GC. */
+  uint32_t nrefs;	/* Number of tables. */
+  uint32_t adictsz;	/* Size of the adaptive string dictionaries or 0. */
+  uint32_t adictnext;	/* Next slot to fill by the encoder. */
+  GCRef adict;		/* Adaptive dictionary of the encoder. */
+  GCRef adictd;		/* Adaptive dictionary of the decoder. */
+  uint32_t adictmark;	/* Value of adictnext at the start of the encode. */
+  uint32_t adictnew;	/* New keys of an unfinished encode, up to adictsz. */
 } SBufExt;
 
 #define sbufsz(sb)		((MSize)((sb)->e - (sb)->b))
@@ -60,6 +72,9 @@ typedef struct SBufExt {
 #define sbufX(sb) \
   (lj_assertG_(G(sbufL(sb)), sbufisext(sb), "not an SBufExt"), (SBufExt *)(sb))
 #define setsbufflag(sb, flag)	(setmrefu((sb)->L, (flag)))
+/* A COW buffer referencing its own GCudata owns a memory-mapped file. */
+#define sbufismap(sbx) \
+  (sbufiscow(sbx) && gcref((sbx)->cowref) == obj2gco((GCudata *)(sbx)-1))
 
 #define tvisbuf(o) \
   (LJ_HASBUFFER && tvisudata(o) && udataV(o)->udtype == UDTYPE_BUFFER)
@@ -70,6 +85,12 @@ LJ_FUNC char *LJ_FASTCALL lj_buf_need2(SBuf *sb, MSize sz);
 LJ_FUNC char *LJ_FASTCALL lj_buf_more2(SBuf *sb, MSize sz);
 LJ_FUNC void LJ_FASTCALL lj_buf_shrink(lua_State *L, SBuf *sb);
 LJ_FUNC char * LJ_FASTCALL lj_buf_tmp(lua_State *L, MSize sz);
+LJ_FUNC void LJ_FASTCALL lj_bufx_unmap(SBufExt *sbx);
+
+/* Buffer storage pool */
+LJ_FUNC void lj_buf_pool_put(global_State *g, char *b, MSize sz);
+LJ_FUNC void lj_buf_pool_trim(global_State *g);
+LJ_FUNC void lj_buf_pool_free(global_State *g);
 
 static LJ_AINLINE void lj_buf_init(lua_State *L, SBuf *sb)
 {
@@ -136,6 +157,7 @@ static LJ_AINLINE void lj_bufx_set_cow(lua_State *L, SBufExt *sbx,
 static LJ_AINLINE void lj_bufx_reset(SBufExt *sbx)
 {
   if (sbufiscow(sbx)) {
+    if (sbufismap(sbx)) lj_bufx_unmap(sbx);
     setmrefu(sbx->L, (mrefu(sbx->L) & ~(GCSize)SBUF_FLAG_COW));
     setgcrefnull(sbx->cowref);
     sbx->b = sbx->e = NULL;
@@ -145,7 +167,8 @@ static LJ_AINLINE void lj_bufx_reset(SBufExt *sbx)
 
 static LJ_AINLINE void lj_bufx_free(lua_State *L, SBufExt *sbx)
 {
-  if (!sbufiscoworborrow(sbx)) lj_mem_free(G(L), sbx->b, sbufsz(sbx));
+  if (!sbufiscoworborrow(sbx)) lj_buf_pool_put(G(L), sbx->b, sbufsz(sbx));
+  else if (sbufismap(sbx)) lj_bufx_unmap(sbx);
   setsbufXL(sbx, L, SBUF_FLAG_EXT);
   setgcrefnull(sbx->cowref);
   sbx->r = sbx->w = sbx->b = sbx->e = NULL;
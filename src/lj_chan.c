@@ -0,0 +1,340 @@
+/*
+** Inter-state message channels.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+**
+** A channel is a bounded lock-free ring of serialized messages, which is
+** allocated outside of any Lua state. Any number of states, each running
+** in its own thread, may send to and receive from the same channel.
+**
+** The ring follows the classic sequence-numbered design: every slot holds
+** the ticket of the next operation that may use it. Senders and receivers
+** claim a ticket with a CAS on head or tail and publish the slot by
+** advancing its sequence number. Messages that don't fit into a slot are
+** stored in a separately allocated block.
+*/
+
+#define lj_chan_c
+#define LUA_CORE
+
+#include "lj_obj.h"
+
+#if LJ_HASBUFFER && LJ_TARGET_POSIX
+#include <stdlib.h>
+#include <time.h>
+#if LJ_TARGET_LINUX
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_state.h"
+#include "lj_serialize.h"
+#include "lj_chan.h"
+#include "lj_vm.h"
+
+#define CHAN_LINE	64	/* Cache line size. Keeps hot fields apart. */
+#define CHAN_SPIN	64	/* Polls before a receiver goes to sleep. */
+#define CHAN_NAP	200000	/* Max. sleep in ns without futexes. */
+
+typedef struct ChanSlot {
+  uint32_t seq;		/* Ticket of the next operation on this slot. */
+  MSize len;		/* Length of the message. */
+  char *big;		/* Message, if it doesn't fit into the slot. */
+} ChanSlot;
+
+struct LJChan {
+  uint32_t refcount;	/* Number of references held by states. */
+  uint32_t mask;	/* Number of slots - 1. */
+  uint32_t stride;	/* Size of a slot, including its header. */
+  uint32_t slotsz;	/* Max. message size stored inline in a slot. */
+  uint32_t waiters;	/* Number of sleeping receivers. */
+  uint32_t wake;	/* Wake-up counter. Also the futex word. */
+  uint64_t id;		/* Handle of the channel. Never reused. */
+  LJChan *next;		/* Next channel in the list of live channels. */
+  char pad1[CHAN_LINE - 6*sizeof(uint32_t) - sizeof(uint64_t) -
+	    sizeof(LJChan *)];
+  uint32_t head;	/* Next ticket for senders. */
+  char pad2[CHAN_LINE - sizeof(uint32_t)];
+  uint32_t tail;	/* Next ticket for receivers. */
+  char pad3[CHAN_LINE - sizeof(uint32_t)];
+};
+
+#define CHAN_HDRSZ	((sizeof(LJChan) + CHAN_LINE-1) & ~(size_t)(CHAN_LINE-1))
+
+#define chan_slot(ch, pos) \
+  ((ChanSlot *)((char *)(ch) + CHAN_HDRSZ + \
+		(size_t)((pos) & (ch)->mask) * (ch)->stride))
+#define chan_data(s)	((char *)((s)+1))
+
+#define chan_loadr(p)		__atomic_load_n((p), __ATOMIC_RELAXED)
+#define chan_loada(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define chan_store(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define chan_cas(p, o, n) \
+  __atomic_compare_exchange_n((p), (o), (n), 1, \
+			      __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define chan_fence()		__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* -- Channel objects ----------------------------------------------------- */
+
+/* List of live channels, for looking up handles. Guarded by chan_lock,
+** which also guards all reference counts.
+*/
+static LJChan *chan_list;
+static uint64_t chan_lastid;
+static uint32_t chan_lock;
+
+static void chan_lock_acquire(void)
+{
+  while (__atomic_exchange_n(&chan_lock, 1, __ATOMIC_ACQUIRE)) ;
+}
+
+static void chan_lock_release(void)
+{
+  __atomic_store_n(&chan_lock, 0, __ATOMIC_RELEASE);
+}
+
+LJChan *lj_chan_new(uint32_t nslots, uint32_t slotsz)
+{
+  uint32_t i, n = 2;
+  uint32_t stride = (uint32_t)((sizeof(ChanSlot) + slotsz + CHAN_LINE-1) &
+			       ~(size_t)(CHAN_LINE-1));
+  void *p;
+  LJChan *ch;
+  while (n < nslots) n += n;
+  if (posix_memalign(&p, CHAN_LINE, CHAN_HDRSZ + (size_t)n * stride))
+    return NULL;
+  ch = (LJChan *)p;
+  memset(ch, 0, sizeof(LJChan));
+  ch->refcount = 1;
+  ch->mask = n-1;
+  ch->stride = stride;
+  ch->slotsz = stride - (uint32_t)sizeof(ChanSlot);
+  for (i = 0; i < n; i++) {
+    ChanSlot *s = chan_slot(ch, i);
+    s->seq = i;
+    s->len = 0;
+    s->big = NULL;
+  }
+  chan_lock_acquire();
+  ch->id = ++chan_lastid;
+  ch->next = chan_list;
+  chan_list = ch;
+  chan_lock_release();
+  return ch;
+}
+
+/* Get a new reference to a live channel. Returns NULL for a bad handle. */
+LJChan *lj_chan_lookup(uint64_t id)
+{
+  LJChan *ch;
+  chan_lock_acquire();
+  for (ch = chan_list; ch; ch = ch->next)
+    if (ch->id == id) {
+      ch->refcount++;
+      break;
+    }
+  chan_lock_release();
+  return ch;
+}
+
+uint64_t lj_chan_id(LJChan *ch)
+{
+  return ch->id;
+}
+
+void lj_chan_unref(LJChan *ch)
+{
+  uint32_t ref;
+  chan_lock_acquire();
+  ref = --ch->refcount;
+  if (ref == 0) {  /* Unlink, so lookups can't find it anymore. */
+    LJChan **pp = &chan_list;
+    while (*pp != ch) pp = &(*pp)->next;
+    *pp = ch->next;
+  }
+  chan_lock_release();
+  if (ref == 0) {
+    uint32_t i;
+    for (i = 0; i <= ch->mask; i++)  /* Free undelivered big messages. */
+      free(chan_slot(ch, i)->big);
+    free(ch);
+  }
+}
+
+/* Number of messages in the channel. Only a snapshot, of course. */
+uint32_t lj_chan_count(LJChan *ch)
+{
+  uint32_t tail = chan_loada(&ch->tail);
+  int32_t n = (int32_t)(chan_loada(&ch->head) - tail);
+  return n > 0 ? (uint32_t)n : 0;
+}
+
+/* -- Sending ------------------------------------------------------------- */
+
+/* Wake up a sleeping receiver after a slot has been published. */
+static void chan_wake(LJChan *ch)
+{
+  chan_fence();  /* Pairs with the fence in chan_block(). */
+  if (chan_loadr(&ch->waiters)) {
+    __atomic_add_fetch(&ch->wake, 1, __ATOMIC_RELEASE);
+#if LJ_TARGET_LINUX
+    syscall(SYS_futex, &ch->wake, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+  }
+}
+
+/* Send a message. Returns 0 if the channel is full. */
+int lj_chan_send(lua_State *L, LJChan *ch, cTValue *o)
+{
+  SBufExt sbx;
+  ChanSlot *s;
+  char *big = NULL;
+  MSize len;
+  uint32_t pos;
+  /* Encode to the temp. buffer first, since the encoder may throw. */
+  memset(&sbx, 0, sizeof(SBufExt));
+  lj_bufx_set_borrow(L, &sbx, &G(L)->tmpbuf);
+  lj_serialize_put(&sbx, o);
+  len = sbufxlen(&sbx);
+  if (len > ch->slotsz) {
+    big = (char *)malloc(len);
+    if (!big) lj_err_mem(L);
+    memcpy(big, sbx.r, len);
+  }
+  pos = chan_loadr(&ch->head);
+  for (;;) {
+    int32_t dif;
+    s = chan_slot(ch, pos);
+    dif = (int32_t)(chan_loada(&s->seq) - pos);
+    if (dif == 0) {
+      if (chan_cas(&ch->head, &pos, pos+1)) break;
+    } else if (dif < 0) {  /* Slot still holds an unreceived message. */
+      free(big);
+      return 0;
+    } else {  /* Lost the race against another sender. */
+      pos = chan_loadr(&ch->head);
+    }
+  }
+  s->len = len;
+  s->big = big;
+  if (!big) memcpy(chan_data(s), sbx.r, len);
+  chan_store(&s->seq, pos+1);
+  chan_wake(ch);
+  return 1;
+}
+
+/* -- Receiving ----------------------------------------------------------- */
+
+/* Claim the next published slot. Returns NULL if the channel is empty. */
+static ChanSlot *chan_claim(LJChan *ch, uint32_t *posp)
+{
+  uint32_t pos = chan_loadr(&ch->tail);
+  for (;;) {
+    ChanSlot *s = chan_slot(ch, pos);
+    int32_t dif = (int32_t)(chan_loada(&s->seq) - (pos+1));
+    if (dif == 0) {
+      if (chan_cas(&ch->tail, &pos, pos+1)) {
+	*posp = pos;
+	return s;
+      }
+    } else if (dif < 0) {
+      return NULL;
+    } else {
+      pos = chan_loadr(&ch->tail);
+    }
+  }
+}
+
+static double chan_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Sleep until the wake-up counter changes or for at most t seconds. */
+static void chan_sleep(LJChan *ch, uint32_t wake, double t)
+{
+  struct timespec ts;
+#if LJ_TARGET_LINUX
+  if (t >= 0) {
+    ts.tv_sec = (time_t)t;
+    ts.tv_nsec = (long)((t - (double)ts.tv_sec) * 1e9);
+  }
+  syscall(SYS_futex, &ch->wake, FUTEX_WAIT_PRIVATE, wake,
+	  t >= 0 ? &ts : NULL, NULL, 0);
+#else
+  /* No portable futex. Take short naps instead. */
+  long ns = CHAN_NAP;
+  if (t >= 0 && t * 1e9 < (double)ns) ns = (long)(t * 1e9);
+  if (chan_loada(&ch->wake) != wake) return;
+  ts.tv_sec = 0;
+  ts.tv_nsec = ns;
+  nanosleep(&ts, NULL);
+#endif
+}
+
+/* Wait for a message for at most t seconds (forever, if t < 0). */
+static ChanSlot *chan_block(LJChan *ch, uint32_t *posp, double t)
+{
+  double deadline = t >= 0 ? chan_now() + t : 0;
+  ChanSlot *s;
+  int i;
+  for (i = 0; i < CHAN_SPIN; i++)
+    if ((s = chan_claim(ch, posp))) return s;
+  __atomic_add_fetch(&ch->waiters, 1, __ATOMIC_SEQ_CST);
+  for (;;) {
+    uint32_t wake = chan_loada(&ch->wake);
+    chan_fence();  /* Pairs with the fence in chan_wake(). */
+    if ((s = chan_claim(ch, posp))) break;
+    if (t >= 0 && (t = deadline - chan_now()) <= 0) break;
+    chan_sleep(ch, wake, t);
+  }
+  __atomic_sub_fetch(&ch->waiters, 1, __ATOMIC_SEQ_CST);
+  return s;
+}
+
+typedef struct ChanMsg {
+  const char *p;	/* Message. */
+  MSize len;		/* Length of message. */
+  ptrdiff_t ofs;	/* Stack offset of result. */
+} ChanMsg;
+
+static TValue *cpdecode(lua_State *L, lua_CFunction dummy, void *ud)
+{
+  ChanMsg *cm = (ChanMsg *)ud;
+  SBufExt sbx;
+  UNUSED(dummy);
+  memset(&sbx, 0, sizeof(SBufExt));
+  lj_bufx_set_cow(L, &sbx, cm->p, cm->len);
+  if (lj_serialize_get(&sbx, restorestack(L, cm->ofs)) != sbx.w)
+    lj_err_caller(L, LJ_ERR_BUFFER_LEFTOV);
+  return NULL;
+}
+
+/* Receive a message. Waits for at most t seconds (forever, if t < 0).
+** Returns 0 if the channel is still empty.
+*/
+int lj_chan_recv(lua_State *L, LJChan *ch, TValue *o, double t)
+{
+  ChanSlot *s;
+  ChanMsg cm;
+  uint32_t pos;
+  int errcode;
+  if (!(s = chan_claim(ch, &pos)) && (t == 0 || !(s = chan_block(ch, &pos, t))))
+    return 0;
+  /* Decode straight from the slot. Always release it, even on errors. */
+  cm.p = s->big ? s->big : chan_data(s);
+  cm.len = s->len;
+  cm.ofs = savestack(L, o);
+  errcode = lj_vm_cpcall(L, NULL, &cm, cpdecode);
+  free(s->big);
+  s->big = NULL;
+  chan_store(&s->seq, pos + ch->mask+1);
+  if (errcode) lj_err_throw(L, errcode);
+  return 1;
+}
+
+#endif
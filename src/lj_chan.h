@@ -0,0 +1,29 @@
+/*
+** Inter-state message channels.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#ifndef _LJ_CHAN_H
+#define _LJ_CHAN_H
+
+#include "lj_obj.h"
+
+#if LJ_HASBUFFER && LJ_TARGET_POSIX
+
+#define LJ_CHAN_MAXSLOTS	0x100000
+#define LJ_CHAN_MAXSLOTSZ	0x10000
+#define LJ_CHAN_SLOTSZ		240	/* Default payload size of a slot. */
+
+typedef struct LJChan LJChan;
+
+LJ_FUNC LJChan *lj_chan_new(uint32_t nslots, uint32_t slotsz);
+LJ_FUNC LJChan *lj_chan_lookup(uint64_t id);
+LJ_FUNC uint64_t lj_chan_id(LJChan *ch);
+LJ_FUNC void lj_chan_unref(LJChan *ch);
+LJ_FUNC int lj_chan_send(lua_State *L, LJChan *ch, cTValue *o);
+LJ_FUNC int lj_chan_recv(lua_State *L, LJChan *ch, TValue *o, double timeout);
+LJ_FUNC uint32_t lj_chan_count(LJChan *ch);
+
+#endif
+
+#endif
@@ -0,0 +1,247 @@
+/*
+** Block compression for string buffers.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+**
+** The block payload uses the LZ4 block format: a sequence of literal runs
+** and back-references into the last 64K of output. Blocks are independent
+** and are prefixed with their raw and packed sizes.
+*/
+
+#define lj_compress_c
+#define LUA_CORE
+
+#include "lj_obj.h"
+
+#if LJ_HASBUFFER
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_compress.h"
+
+#define LZ_HASHBITS	12
+#define LZ_MINMATCH	4
+#define LZ_LASTLIT	5	/* Last 5 bytes are always literals. */
+#define LZ_MFLIMIT	12	/* Last match must start 12 bytes before end. */
+#define LZ_MAXOFS	65535
+#define LZ_SKIPBITS	6	/* Speed up the scan over incompressible data. */
+
+/* Worst-case packed size for len input bytes. */
+#define lz_bound(len)	((len) + (len)/255 + 16)
+
+/* -- Encoder ------------------------------------------------------------- */
+
+static LJ_AINLINE uint32_t lz_hash(uint32_t x)
+{
+  return (x * 2654435761u) >> (32-LZ_HASHBITS);
+}
+
+static LJ_AINLINE uint8_t *lz_wlen(uint8_t *w, MSize n)
+{
+  for (; n >= 255; n -= 255) *w++ = 255;
+  *w++ = (uint8_t)n;
+  return w;
+}
+
+/* Compress [p, p+len) to w. Returns the packed size. */
+static MSize lz_compress(uint8_t *w, const uint8_t *p, MSize len)
+{
+  uint32_t htab[1u << LZ_HASHBITS];
+  const uint8_t *ip = p, *anchor = p, *pe = p + len;
+  uint8_t *w0 = w;
+  MSize n;
+  if (len >= LZ_MFLIMIT+1) {
+    const uint8_t *mflimit = pe - LZ_MFLIMIT, *mlimit = pe - LZ_LASTLIT;
+    memset(htab, 0, sizeof(htab));
+    ip++;
+    while (ip < mflimit) {
+      uint32_t seq = lj_getu32(ip), h = lz_hash(seq);
+      const uint8_t *ref = p + htab[h], *m;
+      uint8_t *token;
+      htab[h] = (uint32_t)(ip - p);
+      if (ref >= ip || ip - ref > LZ_MAXOFS || lj_getu32(ref) != seq) {
+	ip += 1 + ((MSize)(ip - anchor) >> LZ_SKIPBITS);
+	continue;
+      }
+      /* Extend the match backwards and forwards. */
+      while (ip > anchor && ref > p && ip[-1] == ref[-1]) ip--, ref--;
+      m = ip + LZ_MINMATCH; ref += LZ_MINMATCH;
+      while (m + 4 <= mlimit && lj_getu32(m) == lj_getu32(ref)) m += 4, ref += 4;
+      while (m < mlimit && *m == *ref) m++, ref++;
+      /* Emit the sequence. */
+      n = (MSize)(ip - anchor);
+      token = w++;
+      if (n >= 15) { *token = 15 << 4; w = lz_wlen(w, n - 15); }
+      else *token = (uint8_t)(n << 4);
+      memcpy(w, anchor, n); w += n;
+      n = (MSize)(m - ref);  /* Offset. */
+      w[0] = (uint8_t)n; w[1] = (uint8_t)(n >> 8); w += 2;
+      n = (MSize)(m - ip) - LZ_MINMATCH;
+      if (n >= 15) { *token |= 15; w = lz_wlen(w, n - 15); }
+      else *token |= (uint8_t)n;
+      if (m - 2 > p) htab[lz_hash(lj_getu32(m-2))] = (uint32_t)(m-2 - p);
+      ip = anchor = m;
+    }
+  }
+  /* Trailing literals. */
+  n = (MSize)(pe - anchor);
+  if (n >= 15) { *w++ = 15 << 4; w = lz_wlen(w, n - 15); }
+  else *w++ = (uint8_t)(n << 4);
+  memcpy(w, anchor, n); w += n;
+  return (MSize)(w - w0);
+}
+
+/* -- Decoder ------------------------------------------------------------- */
+
+/* Decompress [p, p+len) to exactly wlen bytes at w. Returns 0 on error. */
+static int lz_decompress(uint8_t *w, MSize wlen, const uint8_t *p, MSize len)
+{
+  const uint8_t *pe = p + len;
+  uint8_t *w0 = w, *we = w + wlen;
+  for (;;) {
+    uint32_t token, n, ofs;
+    if (p >= pe) return 0;
+    token = *p++;
+    n = token >> 4;
+    if (n == 15) {
+      uint32_t b;
+      do {
+	if (p >= pe || n > LJ_MAX_BUF) return 0;
+	b = *p++; n += b;
+      } while (b == 255);
+    }
+    if (n > (MSize)(pe - p) || n > (MSize)(we - w)) return 0;
+    memcpy(w, p, n); w += n; p += n;
+    if (p == pe) break;  /* Last sequence has no match. */
+    if (pe - p < 2) return 0;
+    ofs = p[0] | ((uint32_t)p[1] << 8); p += 2;
+    if (ofs == 0 || ofs > (MSize)(w - w0)) return 0;
+    n = token & 15;
+    if (n == 15) {
+      uint32_t b;
+      do {
+	if (p >= pe || n > LJ_MAX_BUF) return 0;
+	b = *p++; n += b;
+      } while (b == 255);
+    }
+    n += LZ_MINMATCH;
+    if (n > (MSize)(we - w)) return 0;
+    if (ofs >= n) {
+      memcpy(w, w - ofs, n); w += n;
+    } else {  /* Overlapping copy, e.g. for runs. */
+      const uint8_t *ref = w - ofs;
+      do { *w++ = *ref++; } while (--n);
+    }
+  }
+  return w == we;
+}
+
+/* -- Block framing ------------------------------------------------------- */
+
+static LJ_AINLINE void compress_wu32(char *w, MSize v)
+{
+  w[0] = (char)v; w[1] = (char)(v >> 8);
+  w[2] = (char)(v >> 16); w[3] = (char)(v >> 24);
+}
+
+static LJ_AINLINE MSize compress_ru32(const char *r)
+{
+  const uint8_t *p = (const uint8_t *)r;
+  return p[0] | ((MSize)p[1] << 8) | ((MSize)p[2] << 16) | ((MSize)p[3] << 24);
+}
+
+/* Write a block for [p, p+len) to w. Returns the block size. */
+static MSize compress_block(char *w, const char *p, MSize len)
+{
+  MSize n = lz_compress((uint8_t *)w + LJ_COMPRESS_HDR,
+			(const uint8_t *)p, len);
+  if (n >= len) {  /* Store incompressible data as-is. */
+    memcpy(w + LJ_COMPRESS_HDR, p, len);
+    n = len;
+  }
+  compress_wu32(w, len);
+  compress_wu32(w + 4, n);
+  return LJ_COMPRESS_HDR + n;
+}
+
+/* Scan the complete blocks in [p, p+len). Returns the consumed length. */
+static MSize compress_scan(lua_State *L, const char *p, MSize len,
+			   MSize *total)
+{
+  MSize pos = 0, sum = 0;
+  while (len - pos >= LJ_COMPRESS_HDR) {
+    MSize raw = compress_ru32(p + pos), packed = compress_ru32(p + pos + 4);
+    if (raw > LJ_MAX_BUF || packed > raw || (packed == 0 && raw != 0) ||
+	raw > LJ_MAX_BUF - sum)
+      lj_err_caller(L, LJ_ERR_BUFFER_BADCOMP);
+    if (packed > len - pos - LJ_COMPRESS_HDR) break;  /* Incomplete. */
+    sum += raw;
+    pos += LJ_COMPRESS_HDR + packed;
+  }
+  *total = sum;
+  return pos;
+}
+
+/* Decode the scanned blocks in [p, p+len) to w. */
+static void compress_unblock(lua_State *L, char *w, const char *p, MSize len)
+{
+  const char *pe = p + len;
+  while (p < pe) {
+    MSize raw = compress_ru32(p), packed = compress_ru32(p + 4);
+    p += LJ_COMPRESS_HDR;
+    if (packed == raw)
+      memcpy(w, p, raw);
+    else if (!lz_decompress((uint8_t *)w, raw, (const uint8_t *)p, packed))
+      lj_err_caller(L, LJ_ERR_BUFFER_BADCOMP);
+    w += raw; p += packed;
+  }
+}
+
+/* -- Buffer operations --------------------------------------------------- */
+
+/* Append one compressed block for [p, p+len). Must not alias the buffer. */
+void lj_compress_put(SBufExt *sbx, const char *p, MSize len)
+{
+  char *w = lj_buf_more((SBuf *)sbx, LJ_COMPRESS_HDR + lz_bound(len));
+  sbx->w = w + compress_block(w, p, len);
+}
+
+/* Append the contents of all complete blocks in [p, p+len).
+** Must not alias the buffer. Returns the consumed length.
+*/
+MSize lj_compress_get(SBufExt *sbx, const char *p, MSize len)
+{
+  MSize total, n = compress_scan(sbufL(sbx), p, len, &total);
+  char *w = lj_buf_more((SBuf *)sbx, total);
+  compress_unblock(sbufL(sbx), w, p, n);
+  sbx->w = w + total;
+  return n;
+}
+
+/* Replace the buffer contents with a single compressed block.
+** The block is built in the free space and then moved down.
+*/
+void LJ_FASTCALL lj_compress_buf(SBufExt *sbx)
+{
+  MSize len = sbufxlen(sbx), n;
+  char *w = lj_buf_more((SBuf *)sbx, LJ_COMPRESS_HDR + lz_bound(len));
+  n = compress_block(w, sbx->r, len);
+  memmove(sbx->r, w, n);
+  sbx->w = sbx->r + n;
+}
+
+/* Replace the buffer contents, which must be complete blocks, with
+** the decompressed data.
+*/
+void LJ_FASTCALL lj_decompress_buf(SBufExt *sbx)
+{
+  lua_State *L = sbufL(sbx);
+  MSize len = sbufxlen(sbx), total;
+  char *w;
+  if (compress_scan(L, sbx->r, len, &total) != len)
+    lj_err_caller(L, LJ_ERR_BUFFER_EOB);
+  w = lj_buf_more((SBuf *)sbx, total);
+  compress_unblock(L, w, sbx->r, len);
+  memmove(sbx->r, w, total);
+  sbx->w = sbx->r + total;
+}
+
+#endif
@@ -0,0 +1,23 @@
+/*
+** Block compression for string buffers.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#ifndef _LJ_COMPRESS_H
+#define _LJ_COMPRESS_H
+
+#include "lj_obj.h"
+#include "lj_buf.h"
+
+#if LJ_HASBUFFER
+
+#define LJ_COMPRESS_HDR		8	/* Block header: raw size, packed size. */
+
+LJ_FUNC void lj_compress_put(SBufExt *sbx, const char *p, MSize len);
+LJ_FUNC MSize lj_compress_get(SBufExt *sbx, const char *p, MSize len);
+LJ_FUNC void LJ_FASTCALL lj_compress_buf(SBufExt *sbx);
+LJ_FUNC void LJ_FASTCALL lj_decompress_buf(SBufExt *sbx);
+
+#endif
+
+#endif
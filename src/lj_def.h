@@ -55,12 +55,14 @@ typedef unsigned int uintptr_t;
 #define LJ_MAX_STR	LJ_MAX_MEM32	/* Max. string length. */
 #define LJ_MAX_BUF	LJ_MAX_MEM32	/* Max. buffer length. */
 #define LJ_MAX_UDATA	LJ_MAX_MEM32	/* Max. userdata length. */
+#define LJ_MAX_POOLSBUF	65536		/* Max. size of pooled buffer storage. */
 
 #define LJ_MAX_STRTAB	(1<<26)		/* Max. string table size. */
 #define LJ_MAX_HBITS	26		/* Max. hash bits. */
 #define LJ_MAX_ABITS	28		/* Max. bits of array key. */
 #define LJ_MAX_ASIZE	((1<<(LJ_MAX_ABITS-1))+1)  /* Max. array part size. */
 #define LJ_MAX_COLOSIZE	16		/* Max. elems for colocated array. */
+#define LJ_MAX_COLOHBITS	2		/* Max. hbits for colocated hash. */
 
 #define LJ_MAX_LINE	LJ_MAX_MEM32	/* Max. source code line number. */
 #define LJ_MAX_XLEVEL	200		/* Max. syntactic nesting level. */
@@ -79,6 +81,7 @@ typedef unsigned int uintptr_t;
 #define LJ_MIN_REGISTRY	2		/* Min. registry size (hbits). */
 #define LJ_MIN_STRTAB	256		/* Min. string table size (pow2). */
 #define LJ_MIN_SBUF	32		/* Min. string buffer length. */
+#define LJ_POOLSBUF_MEM	(1<<20)		/* Default max. size of buffer pool. */
 #define LJ_MIN_VECSZ	8		/* Min. size for growable vectors. */
 #define LJ_MIN_IRSZ	32		/* Min. size for growable IR. */
 
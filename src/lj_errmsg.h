@@ -22,6 +22,11 @@ ERRDEF(TABOV,	"table overflow")
 ERRDEF(NANIDX,	"table index is NaN")
 ERRDEF(NILIDX,	"table index is nil")
 ERRDEF(NEXTIDX,	"invalid key to " LUA_QL("next"))
+ERRDEF(FROZEN,	"attempt to modify a frozen table")
+ERRDEF(FREEZE,	"attempt to freeze a %s value")
+#if !LJ_TARGET_X86ORX64
+ERRDEF(NYIFREEZE,	"NYI: frozen tables on this architecture")
+#endif
 
 /* Metamethod resolving. */
 ERRDEF(BADCALL,	"attempt to call a %s value")
@@ -85,6 +90,10 @@ ERRDEF(TABCAT,	"invalid value (%s) at index %d in table for " LUA_QL("concat"))
 ERRDEF(TABSORT,	"invalid order function for sorting")
 ERRDEF(IOCLFL,	"attempt to use a closed file")
 ERRDEF(IOSTDCL,	"standard file is closed")
+ERRDEF(IOEVCO,	"not called from an event coroutine")
+ERRDEF(IOEVBUSY,	"descriptor already has a waiter")
+ERRDEF(IOEVRUN,	"event loop already running")
+ERRDEF(IOEVOS,	"no event loop on this OS")
 ERRDEF(OSUNIQF,	"unable to generate a unique filename")
 ERRDEF(OSDATEF,	"field " LUA_QS " missing in date table")
 ERRDEF(STRDUMP,	"unable to dump given function")
@@ -148,6 +157,12 @@ ERRDEF(XGSCOPE,	"<goto %s> jumps into the scope of local " LUA_QS)
 ERRDEF(BCFMT,	"cannot load incompatible bytecode")
 ERRDEF(BCBAD,	"cannot load malformed bytecode")
 
+/* Heap image errors. */
+ERRDEF(IMGSAVE,	"cannot save %s in heap image")
+ERRDEF(IMGFMT,	"cannot load incompatible heap image")
+ERRDEF(IMGBAD,	"cannot load malformed heap image")
+ERRDEF(IMGNOBJ,	"cannot restore %s missing from this state")
+
 #if LJ_HASFFI
 /* FFI errors. */
 ERRDEF(FFI_INVTYPE,	"invalid C type")
@@ -188,10 +203,17 @@ ERRDEF(BUFFER_BADOPT,	"bad options table")
 ERRDEF(BUFFER_BADENC,	"cannot serialize " LUA_QS)
 ERRDEF(BUFFER_BADDEC,	"cannot deserialize tag 0x%02x")
 ERRDEF(BUFFER_BADDICTX,	"cannot deserialize dictionary index %d")
+ERRDEF(BUFFER_BADREF,	"cannot deserialize reference %d")
 ERRDEF(BUFFER_DEPTH,	"too deep to serialize")
 ERRDEF(BUFFER_DUPKEY,	"duplicate table key")
 ERRDEF(BUFFER_EOB,	"unexpected end of buffer")
 ERRDEF(BUFFER_LEFTOV,	"left-over data in buffer")
+ERRDEF(BUFFER_BADCOMP,	"malformed compressed data")
+ERRDEF(BUFFER_DUPBUF,	"duplicate buffer")
+ERRDEF(BUFFER_IOVMAX,	"too many buffers")
+ERRDEF(BUFFER_MAPSZ,	"file too large to map")
+ERRDEF(BUFFER_BADJSON,	"malformed JSON at offset %d")
+ERRDEF(BUFFER_BADCHAN,	"invalid channel handle")
 #endif
 
 #undef ERRDEF
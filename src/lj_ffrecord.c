@@ -31,6 +31,8 @@
 #include "lj_strscan.h"
 #include "lj_strfmt.h"
 #include "lj_serialize.h"
+#include "lj_json.h"
+#include "lj_io.h"
 
 /* Some local macros to save typing. Undef'd at the end. */
 #define IR(ref)			(&J->cur.ir[(ref)])
@@ -243,6 +245,7 @@ static void LJ_FASTCALL recff_setmetatable(jit_State *J, RecordFFData *rd)
     ix.tab = tr;
     copyTV(J->L, &ix.tabv, &rd->argv[0]);
     lj_record_mm_lookup(J, &ix, MM_metatable); /* Guard for no __metatable. */
+    lj_record_unfrozen(J, tr);
     fref = emitir(IRT(IR_FREF, IRT_PGC), tr, IRFL_TAB_META);
     mtref = tref_isnil(mt) ? lj_ir_knull(J, IRT_TAB) : mt;
     emitir(IRT(IR_FSTORE, IRT_TAB), fref, mtref);
@@ -302,6 +305,52 @@ static void LJ_FASTCALL recff_rawlen(jit_State *J, RecordFFData *rd)
 }
 #endif
 
+static void LJ_FASTCALL recff_unpack(jit_State *J, RecordFFData *rd)
+{
+  TRef tab = J->base[0];
+  if (tref_istab(tab)) {
+    GCtab *t = tabV(&rd->argv[0]);
+    TRef tri = lj_ir_kint(J, 1), tre;
+    int32_t i = 1, e, k, n;
+    ptrdiff_t nres = results_wanted(J);
+    RecordIndex ix;
+    if (J->base[1] && !tref_isnil(J->base[1])) {
+      tri = lj_opt_narrow_toint(J, J->base[1]);
+      i = argv2int(J, &rd->argv[1]);
+    }
+    if (J->base[1] && J->base[2] && !tref_isnil(J->base[2])) {
+      tre = lj_opt_narrow_toint(J, J->base[2]);
+      e = argv2int(J, &rd->argv[2]);
+    } else {
+      tre = emitir(IRTI(IR_ALEN), tab, TREF_NIL);
+      e = (int32_t)lj_tab_len(t);
+    }
+    if (i > e) {  /* Empty range. */
+      emitir(IRTGI(IR_GT), tri, tre);
+      rd->nres = 0;
+      return;
+    }
+    if ((uint32_t)e - (uint32_t)i >= LJ_MAX_JSLOTS - J->baseslot) {
+      recff_nyiu(J, rd);  /* Too many results. */
+      return;
+    }
+    /* Specialize to the number of results. */
+    n = e - i + 1;
+    emitir(IRTGI(IR_EQ), tre, tref_isk(tri) ? lj_ir_kint(J, e) :
+	   emitir(IRTGI(IR_ADDOV), tri, lj_ir_kint(J, n-1)));
+    if (nres >= 0 && nres < n) n = (int32_t)nres;  /* Drop unused loads. */
+    ix.tab = tab; ix.val = 0; ix.idxchain = 0;
+    settabV(J->L, &ix.tabv, t);
+    for (k = 0; k < n; k++) {
+      ix.key = tref_isk(tri) ? lj_ir_kint(J, i+k) :
+	       k ? emitir(IRTI(IR_ADD), tri, lj_ir_kint(J, k)) : tri;
+      setintV(&ix.keyv, i+k);
+      J->base[k] = lj_record_idx(J, &ix);
+    }
+    rd->nres = n;
+  }  /* else: Interpreter will throw. */
+}
+
 /* Determine mode of select() call. */
 int32_t lj_ffrecord_select_mode(jit_State *J, TRef tr, TValue *tv)
 {
@@ -1164,11 +1213,18 @@ static void LJ_FASTCALL recff_buffer_method_reset(jit_State *J, RecordFFData *rd
   TRef ud = recff_sbufx_check(J, rd, 0);
   SBufExt *sbx = bufV(&rd->argv[0]);
   int iscow = (int)sbufiscow(sbx);
-  TRef trl = recff_sbufx_get_L(J, ud);
-  TRef trcow = emitir(IRT(IR_BAND, IRT_IGC), trl, lj_ir_kint(J, SBUF_FLAG_COW));
-  TRef zero = lj_ir_kint(J, 0);
+  TRef trl, trcow, zero;
+  if (sbufismap(sbx)) {  /* Need to release the mapping. */
+    recff_nyiu(J, rd);
+    return;
+  }
+  trl = recff_sbufx_get_L(J, ud);
+  trcow = emitir(IRT(IR_BAND, IRT_IGC), trl, lj_ir_kint(J, SBUF_FLAG_COW));
+  zero = lj_ir_kint(J, 0);
   emitir(IRTG(iscow ? IR_NE : IR_EQ, IRT_IGC), trcow, zero);
   if (iscow) {
+    TRef trref = emitir(IRT(IR_FLOAD, IRT_PGC), ud, IRFL_SBUF_REF);
+    emitir(IRTG(IR_NE, IRT_PGC), trref, ud);
     trl = emitir(IRT(IR_BXOR, IRT_IGC), trl,
 		 LJ_GC64 ? lj_ir_kint64(J, SBUF_FLAG_COW) :
 			   lj_ir_kint(J, SBUF_FLAG_COW));
@@ -1369,6 +1425,28 @@ static void LJ_FASTCALL recff_buffer_method_decode(jit_State *J, RecordFFData *r
   recff_sbufx_set_ptr(J, ud, IRFL_SBUF_R, trr);
 }
 
+static void LJ_FASTCALL recff_buffer_method_putjson(jit_State *J, RecordFFData *rd)
+{
+  TRef ud = recff_sbufx_check(J, rd, 0);
+  TRef trbuf = recff_sbufx_write(J, ud);
+  TRef tmp = recff_tmpref(J, J->base[1], IRTMPREF_IN1);
+  lj_ir_call(J, IRCALL_lj_json_put, trbuf, tmp);
+  /* No IR_USE needed, since the call is a store. */
+}
+
+static void LJ_FASTCALL recff_buffer_method_getjson(jit_State *J, RecordFFData *rd)
+{
+  TRef ud = recff_sbufx_check(J, rd, 0);
+  TRef trbuf = recff_sbufx_write(J, ud);
+  TRef tmp = recff_tmpref(J, TREF_NIL, IRTMPREF_OUT1);
+  TRef trr = lj_ir_call(J, IRCALL_lj_json_get, trbuf, tmp);
+  IRType t = (IRType)lj_json_peektype(bufV(&rd->argv[0]));
+  /* No IR_USE needed, since the call is a store. */
+  J->base[0] = lj_record_vload(J, tmp, 0, t);
+  /* The sbx->r store must be after the VLOAD type check, in case it fails. */
+  recff_sbufx_set_ptr(J, ud, IRFL_SBUF_R, trr);
+}
+
 static void LJ_FASTCALL recff_buffer_encode(jit_State *J, RecordFFData *rd)
 {
   TRef tmp = recff_tmpref(J, J->base[0], IRTMPREF_IN1);
@@ -1401,6 +1479,71 @@ static void LJ_FASTCALL recff_buffer_decode(jit_State *J, RecordFFData *rd)
 
 /* -- Table library fast functions ---------------------------------------- */
 
+static void LJ_FASTCALL recff_table_remove(jit_State *J, RecordFFData *rd)
+{
+  TRef tab = J->base[0];
+  rd->nres = 0;
+  if (tref_istab(tab)) {
+    GCtab *t = tabV(&rd->argv[0]);
+    TRef trlen = emitir(IRTI(IR_ALEN), tab, TREF_NIL);
+    int32_t len = (int32_t)lj_tab_len(t);
+    TRef trpos = trlen;
+    int32_t pos = len;
+    RecordIndex ix;
+    if (J->base[1] && !tref_isnil(J->base[1])) {  /* table.remove(t, pos) */
+      trpos = lj_opt_narrow_toint(J, J->base[1]);
+      pos = argv2int(J, &rd->argv[1]);
+      if (pos < 1) {  /* Nothing to remove. */
+	emitir(IRTGI(IR_LT), trpos, lj_ir_kint(J, 1));
+	return;
+      } else if (pos > len) {
+	emitir(IRTGI(IR_GT), trpos, trlen);
+	return;
+      }
+      emitir(IRTGI(IR_GE), trpos, lj_ir_kint(J, 1));
+      emitir(IRTGI(IR_LE), trpos, trlen);
+    } else if (len == 0) {  /* Nothing to remove. */
+      emitir(IRTGI(IR_EQ), trlen, lj_ir_kint(J, 0));
+      return;
+    } else {
+      emitir(IRTGI(IR_NE), trlen, lj_ir_kint(J, 0));
+    }
+    lj_record_unfrozen(J, tab);
+    ix.tab = tab; ix.key = trpos; ix.val = 0; ix.idxchain = 0;
+    settabV(J->L, &ix.tabv, t);
+    setintV(&ix.keyv, pos);
+    J->base[0] = lj_record_idx(J, &ix);  /* Load old value. */
+    if (pos < len) {  /* Shift down the remaining elements. */
+      TRef trpos1 = emitir(IRTI(IR_ADD), trpos, lj_ir_kint(J, 1));
+      lj_ir_call(J, IRCALL_lj_tab_move, tab, trpos1, trlen, trpos, tab);
+    } else if (trpos != trlen) {
+      emitir(IRTGI(IR_EQ), trpos, trlen);
+    }
+    ix.key = trlen; ix.val = TREF_NIL;
+    setintV(&ix.keyv, len);
+    setnilV(&ix.valv);
+    lj_record_idx(J, &ix);  /* Clear last element. */
+    rd->nres = 1;
+  }  /* else: Interpreter will throw. */
+}
+
+static void LJ_FASTCALL recff_table_move(jit_State *J, RecordFFData *rd)
+{
+  TRef a1 = J->base[0], a2 = a1;
+  if (tref_istab(a1) && J->base[1] && J->base[2] && J->base[3]) {
+    TRef trf = lj_opt_narrow_toint(J, J->base[1]);
+    TRef tre = lj_opt_narrow_toint(J, J->base[2]);
+    TRef trt = lj_opt_narrow_toint(J, J->base[3]);
+    if (J->base[4] && !tref_isnil(J->base[4])) {
+      a2 = J->base[4];
+      if (!tref_istab(a2)) return;  /* Interpreter will throw. */
+    }
+    lj_record_unfrozen(J, a2);
+    lj_ir_call(J, IRCALL_lj_tab_move, a1, trf, tre, trt, a2);
+    J->base[0] = a2;
+  }  /* else: Interpreter will throw. */
+}
+
 static void LJ_FASTCALL recff_table_insert(jit_State *J, RecordFFData *rd)
 {
   RecordIndex ix;
@@ -1455,6 +1598,7 @@ static void LJ_FASTCALL recff_table_clear(jit_State *J, RecordFFData *rd)
   TRef tr = J->base[0];
   if (tref_istab(tr)) {
     rd->nres = 0;
+    lj_record_unfrozen(J, tr);
     lj_ir_call(J, IRCALL_lj_tab_clear, tr);
     J->needsnap = 1;
   }  /* else: Interpreter will throw. */
@@ -1519,6 +1663,35 @@ static void LJ_FASTCALL recff_io_flush(jit_State *J, RecordFFData *rd)
   J->base[0] = TREF_TRUE;
 }
 
+/* The iterator is specialized to its ffid and passed to the helper, since
+** each io.lines() call creates a new one. The end of the file, a closed file
+** or another kind of iterator exits the trace. The interpreter then handles
+** it, e.g. closes the file for io.lines(fname).
+*/
+static void LJ_FASTCALL recff_io_lines_iter(jit_State *J, RecordFFData *rd)
+{
+  GCfunc *fn = J->fn;
+  IOFileUD *iof = (IOFileUD *)uddata(udataV(&fn->c.upvalue[0]));
+  int32_t kind = lj_io_lineskind(fn);
+  TRef trfn = J->base[-1-LJ_FR2], tr;
+  /* The trace can only continue with a line. EOF is left to the VM. */
+  if (kind < 0 || lj_io_ateof(iof)) {
+    recff_nyiu(J, rd);
+    return;
+  }
+#if LJ_HASBUFFER
+  if (kind == IOLINES_BUF) {
+    tr = lj_ir_call(J, IRCALL_lj_io_linesnext_buf, trfn);
+    emitir(IRTG(IR_NE, IRT_UDATA), tr, lj_ir_knull(J, IRT_UDATA));
+    J->base[0] = tr;
+    return;
+  }
+#endif
+  tr = lj_ir_call(J, IRCALL_lj_io_linesnext, trfn, lj_ir_kint(J, kind));
+  emitir(IRTG(IR_NE, IRT_STR), tr, lj_ir_knull(J, IRT_STR));
+  J->base[0] = tr;
+}
+
 /* -- Debug library fast functions ---------------------------------------- */
 
 static void LJ_FASTCALL recff_debug_getmetatable(jit_State *J, RecordFFData *rd)
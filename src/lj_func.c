@@ -13,8 +13,10 @@
 #include "lj_obj.h"
 #include "lj_gc.h"
 #include "lj_func.h"
+#include "lj_frame.h"
 #include "lj_trace.h"
 #include "lj_vm.h"
+#include "lj_bcdump.h"
 
 /* -- Prototypes ---------------------------------------------------------- */
 
@@ -162,6 +164,10 @@ GCfunc *lj_func_newL_gc(lua_State *L, GCproto *pt, GCfuncL *parent)
   MSize i, nuv;
   TValue *base;
   lj_gc_check_fixtop(L);
+  if (LJ_UNLIKELY(proto_islazy(pt))) {
+    L->top = curr_topL(L);
+    pt = lj_bcread_lazy(L, funcproto((GCfunc *)parent), pt);
+  }
   fn = func_newL(L, pt, tabref(parent->env));
   /* NOBARRIER: The GCfunc is new (marked white). */
   puv = parent->uvptr;
@@ -74,6 +74,10 @@ static void gc_mark(global_State *g, GCobj *o)
 	gc_markobj(g, gcref(sbx->dict_str));
       if (gcref(sbx->dict_mt))
 	gc_markobj(g, gcref(sbx->dict_mt));
+      if (gcref(sbx->adict)) {
+	gc_markobj(g, gcref(sbx->adict));
+	gc_markobj(g, gcref(sbx->adictd));
+      }
     }
   } else if (LJ_UNLIKELY(gct == ~LJ_TUPVAL)) {
     GCupval *uv = gco2uv(o);
@@ -178,7 +182,7 @@ static int gc_traverse_tab(global_State *g, GCtab *t)
   if (mt)
     gc_markobj(g, mt);
   mode = lj_meta_fastg(g, mt, MM_mode);
-  if (mode && tvisstr(mode)) {  /* Valid __mode field? */
+  if (mode && tvisstr(mode) && !isfrozen(obj2gco(t))) {  /* Valid __mode? */
     const char *modestr = strVdata(mode);
     int c;
     while ((c = *modestr++)) {
@@ -325,7 +329,8 @@ static size_t propagatemark(global_State *g)
 {
   GCobj *o = gcref(g->gc.gray);
   int gct = o->gch.gct;
-  lj_assertG(isgray(o), "propagation of non-gray object");
+  /* A gray table may have been frozen (and made black) in the meantime. */
+  lj_assertG(isgray(o) || isfrozen(o), "propagation of non-gray object");
   gray2black(o);
   setgcrefr(g->gc.gray, o->gch.gclist);  /* Remove from gray list. */
   if (LJ_LIKELY(gct == ~LJ_TTAB)) {
@@ -413,6 +418,16 @@ static GCRef *gc_sweep(global_State *g, GCRef *p, uint32_t lim)
     if (((o->gch.marked ^ LJ_GC_WHITES) & ow)) {  /* Black or current white? */
       lj_assertG(!isdead(g, o) || (o->gch.marked & LJ_GC_FIXED),
 		 "sweep of undead object");
+      if (LJ_UNLIKELY(o->gch.marked & LJ_GC_FROZEN)) {
+	/* Move frozen object to its own list. It's never swept again. */
+	setgcrefr(*p, o->gch.nextgc);
+	if (o == gcref(g->gc.root))
+	  setgcrefr(g->gc.root, o->gch.nextgc);  /* Adjust list anchor. */
+	o->gch.marked = (o->gch.marked & (uint8_t)~LJ_GC_COLORS) | LJ_GC_BLACK;
+	setgcrefr(o->gch.nextgc, g->gc.frozen);
+	setgcref(g->gc.frozen, o);
+	continue;
+      }
       makewhite(g, o);  /* Value is alive, change to the current white. */
       p = &o->gch.nextgc;
     } else {  /* Otherwise value is dead, free it. */
@@ -607,6 +622,7 @@ void lj_gc_freeall(global_State *g)
   /* Free everything, except super-fixed objects (the main thread). */
   g->gc.currentwhite = LJ_GC_WHITES | LJ_GC_SFIXED;
   gc_fullsweep(g, &g->gc.root);
+  gc_fullsweep(g, &g->gc.frozen);
   strmask = g->str.mask;
   for (i = 0; i <= strmask; i++)  /* Free all string hash chains. */
     gc_sweepstr(g, &g->str.tab[i]);
@@ -642,6 +658,7 @@ static void atomic(global_State *g, lua_State *L)
   gc_clearweak(g, gcref(g->gc.weak));
 
   lj_buf_shrink(L, &g->tmpbuf);  /* Shrink temp buffer. */
+  lj_buf_pool_trim(g);  /* Shrink buffer pool. */
 
   /* Prepare for sweep phase. */
   g->gc.currentwhite = (uint8_t)otherwhite(g);  /* Flip current white. */
@@ -801,6 +818,88 @@ void lj_gc_fullgc(lua_State *L)
   g->vmstate = ostate;
 }
 
+/* -- Frozen tables ------------------------------------------------------- */
+
+/* Add a value to the set of tables to freeze or check that it's immutable. */
+static void gc_freeze_tv(lua_State *L, GCtab *set, cTValue *o, int32_t *n)
+{
+  if (tvistab(o)) {
+    if (!isfrozen(gcV(o))) {
+      TValue *tv = lj_tab_set(L, set, o);
+      if (tvisnil(tv)) {  /* Not seen, yet. Append it to the worklist. */
+	int32_t i = ++*n;
+	setboolV(tv, 1);
+	settabV(L, lj_tab_setint(L, set, i), tabV(o));
+      }
+    }
+  } else if (tvisgcv(o) && !tvisstr(o)) {
+    lj_err_callerv(L, LJ_ERR_FREEZE, lj_typename(o));
+  }
+}
+
+/* Freeze a table and all tables reachable from it.
+**
+** All keys and values must be immutable: strings, numbers, booleans,
+** lightuserdata or frozen tables. Frozen tables are black and never become
+** white again, so they're never marked or traversed. Their strings are
+** fixed. The sweep phase moves them off the root list, so the collector
+** never touches their memory again (and it stays shared after fork()).
+** Modifying a frozen table raises an error.
+*/
+void lj_gc_freeze(lua_State *L, GCtab *t)
+{
+  GCtab *set;
+  TValue tv;
+  int32_t i, n = 0;
+#if !LJ_TARGET_X86ORX64
+  /* NYI: the interpreters of the other ports don't check for frozen tables. */
+  lj_err_caller(L, LJ_ERR_NYIFREEZE);
+#endif
+  if (isfrozen(obj2gco(t))) return;
+  set = lj_tab_new(L, 0, 0);
+  settabV(L, L->top, set);  /* Anchor the set. */
+  incr_top(L);
+  settabV(L, &tv, t);
+  gc_freeze_tv(L, set, &tv, &n);
+  for (i = 1; i <= n; i++) {  /* Check everything before freezing anything. */
+    GCtab *ot = tabV(lj_tab_getint(set, i));
+    Node *node = noderef(ot->node);
+    uint32_t j;
+    if (tabref(ot->metatable)) {
+      settabV(L, &tv, tabref(ot->metatable));
+      gc_freeze_tv(L, set, &tv, &n);
+    }
+    for (j = 0; j < ot->asize; j++)
+      gc_freeze_tv(L, set, arrayslot(ot, j), &n);
+    for (j = 0; j <= ot->hmask; j++) {
+      Node *nd = &node[j];
+      if (!tvisnil(&nd->val)) {
+	gc_freeze_tv(L, set, &nd->key, &n);
+	gc_freeze_tv(L, set, &nd->val, &n);
+      }
+    }
+  }
+  for (i = 1; i <= n; i++) {
+    GCtab *ot = tabV(lj_tab_getint(set, i));
+    Node *node = noderef(ot->node);
+    uint32_t j;
+    for (j = 0; j < ot->asize; j++) {
+      TValue *o = arrayslot(ot, j);
+      if (tvisstr(o)) fixstring(strV(o));
+    }
+    for (j = 0; j <= ot->hmask; j++) {
+      Node *nd = &node[j];
+      if (!tvisnil(&nd->val)) {
+	if (tvisstr(&nd->key)) fixstring(strV(&nd->key));
+	if (tvisstr(&nd->val)) fixstring(strV(&nd->val));
+      }
+    }
+    ot->marked = (ot->marked & (uint8_t)~LJ_GC_COLORS) |
+		 LJ_GC_BLACK | LJ_GC_FROZEN;
+  }
+  L->top--;
+}
+
 /* -- Write barriers ------------------------------------------------------ */
 
 /* Move the GC propagation frontier forward. */
@@ -0,0 +1,848 @@
+/*
+** Heap images.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+**
+** A heap image holds everything reachable from the registry, the globals
+** and the base metatables of a state. It's restored into a fresh state of
+** the same binary with the same libraries opened. C functions and userdata
+** are never written out. They're matched up with their counterparts in the
+** current state by walking both object graphs in parallel from the roots.
+*/
+
+#define lj_image_c
+#define LUA_CORE
+
+#include "lauxlib.h"
+
+#include "lj_obj.h"
+#include "lj_gc.h"
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_str.h"
+#include "lj_tab.h"
+#include "lj_func.h"
+#include "lj_udata.h"
+#include "lj_state.h"
+#include "lj_trace.h"
+#include "lj_strfmt.h"
+#include "lj_bcdump.h"
+#include "lj_image.h"
+
+/*
+** image  = header nobjU root object*
+** header = ESC 'L' 'J' 'I' versionB flagsU
+** root   = registryU globalsU nbasemtU basemtU*
+** object = idU typeB payload
+** str    = lenU char*
+** tab    = asizeU hbitsU flagsB mtU nkvU (val val)*
+** lfunc  = protoU envU nuvU upvalU*
+** cfunc  = ffidB nuvU envU val*       (also bytecode builtins)
+** udata  = udtypeB mtU envU
+** upval  = val
+** dump   = lenU bytecode
+** proto  = dumpU indexU
+** val    = nil | false | true | int intU | num 8*byte | ref idU
+**
+** Object ids start at 1, an id of 0 means none. A dump holds a prototype
+** together with all of its inner prototypes. A proto is identified by its
+** index in a pre-order walk of the prototype tree of a dump.
+*/
+
+#define IMAGE_VERSION		1
+
+#define IMAGE_F_BE		0x01
+
+#define IMAGE_TAB_FROZEN	0x01
+
+#define IMAGE_NBASEMT		(GCROOT_BASEMT_NUM-GCROOT_BASEMT+1)
+
+/* Object types. Only the types up to and including udata are values. */
+enum {
+  IMAGE_OBJ_STR, IMAGE_OBJ_TAB, IMAGE_OBJ_LFUNC, IMAGE_OBJ_CFUNC,
+  IMAGE_OBJ_UDATA, IMAGE_OBJ_UPVAL, IMAGE_OBJ_DUMP, IMAGE_OBJ_PROTO
+};
+
+/* Value tags. */
+enum {
+  IMAGE_VAL_NIL, IMAGE_VAL_FALSE, IMAGE_VAL_TRUE, IMAGE_VAL_INT,
+  IMAGE_VAL_NUM, IMAGE_VAL_REF
+};
+
+/* -- Save heap image ----------------------------------------------------- */
+
+/* Context for saving a heap image. */
+typedef struct ImageCtx {
+  lua_State *L;
+  SBuf *sb;		/* Output buffer for objects. */
+  GCtab *ids;		/* Object -> id. */
+  GCtab *objs;		/* Id -> object. */
+  uint32_t nobj;	/* Number of objects. */
+} ImageCtx;
+
+static void image_putu(ImageCtx *ctx, uint32_t v)
+{
+  SBuf *sb = ctx->sb;
+  sb->w = lj_strfmt_wuleb128(lj_buf_more(sb, 5), v);
+}
+
+/* Get the id of an object. New objects are queued for writing. */
+static uint32_t image_ref(ImageCtx *ctx, cTValue *o)
+{
+  lua_State *L = ctx->L;
+  cTValue *tv = lj_tab_get(L, ctx->ids, o);
+  uint32_t id;
+  if (tvisnum(tv))
+    return (uint32_t)numV(tv);
+  if (tvisthread(o) || tviscdata(o))
+    lj_err_callerv(L, LJ_ERR_IMGSAVE, lj_typename(o));
+  id = ++ctx->nobj;
+  setnumV(lj_tab_set(L, ctx->ids, o), (lua_Number)id);
+  copyTV(L, lj_tab_setint(L, ctx->objs, (int32_t)id), o);
+  lj_gc_anybarriert(L, ctx->ids);
+  lj_gc_anybarriert(L, ctx->objs);
+  return id;
+}
+
+static uint32_t image_reftab(ImageCtx *ctx, GCtab *t)
+{
+  TValue tv;
+  if (!t) return 0;
+  settabV(ctx->L, &tv, t);
+  return image_ref(ctx, &tv);
+}
+
+static void image_putval(ImageCtx *ctx, cTValue *o)
+{
+  SBuf *sb = ctx->sb;
+  char *w;
+  if (tvisgcv(o)) {
+    uint32_t id = image_ref(ctx, o);
+    w = lj_buf_more(sb, 1+5);
+    *w++ = IMAGE_VAL_REF;
+    w = lj_strfmt_wuleb128(w, id);
+  } else if (tvisnumber(o)) {
+    lua_Number n = numberVnum(o);
+    int32_t k = lj_num2int(n);
+    w = lj_buf_more(sb, 1+8);
+    if (tvisint(o) ||
+	((lua_Number)k == n && o->u64 != U64x(80000000,00000000))) {
+      *w++ = IMAGE_VAL_INT;
+      w = lj_strfmt_wuleb128(w, (uint32_t)k);
+    } else {
+      *w++ = IMAGE_VAL_NUM;
+      memcpy(w, &o->u64, 8);
+      w += 8;
+    }
+  } else if (tvislightud(o)) {
+    lj_err_callerv(ctx->L, LJ_ERR_IMGSAVE, lj_typename(o));
+  } else {
+    w = lj_buf_more(sb, 1);
+    *w++ = tvisnil(o) ? IMAGE_VAL_NIL :
+	   tvistrue(o) ? IMAGE_VAL_TRUE : IMAGE_VAL_FALSE;
+  }
+  sb->w = w;
+}
+
+static void image_putobj(ImageCtx *ctx, uint32_t id, cTValue *o)
+{
+  lua_State *L = ctx->L;
+  SBuf *sb = ctx->sb;
+  image_putu(ctx, id);
+  if (tvisstr(o)) {
+    GCstr *s = strV(o);
+    lj_buf_putb(sb, IMAGE_OBJ_STR);
+    image_putu(ctx, s->len);
+    lj_buf_putmem(sb, strdata(s), s->len);
+  } else if (tvistab(o)) {
+    GCtab *t = tabV(o);
+    Node *node = noderef(t->node);
+    uint32_t i, n = 0, hmask = t->hmask;
+    for (i = 0; i < t->asize; i++)
+      if (!tvisnil(arrayslot(t, i))) n++;
+    for (i = 0; i <= hmask; i++)
+      if (!tvisnil(&node[i].val)) n++;
+    lj_buf_putb(sb, IMAGE_OBJ_TAB);
+    image_putu(ctx, t->asize);
+    image_putu(ctx, hmask ? lj_fls(hmask)+1 : 0);
+    lj_buf_putb(sb, isfrozen(obj2gco(t)) ? IMAGE_TAB_FROZEN : 0);
+    image_putu(ctx, image_reftab(ctx, tabref(t->metatable)));
+    image_putu(ctx, n);
+    for (i = 0; i < t->asize; i++) {
+      cTValue *v = arrayslot(t, i);
+      if (!tvisnil(v)) {
+	TValue k;
+	setintV(&k, (int32_t)i);
+	image_putval(ctx, &k);
+	image_putval(ctx, v);
+      }
+    }
+    for (i = 0; i <= hmask; i++) {
+      Node *nd = &node[i];
+      if (!tvisnil(&nd->val)) {
+	image_putval(ctx, &nd->key);
+	image_putval(ctx, &nd->val);
+      }
+    }
+  } else if (tvisfunc(o)) {
+    GCfunc *fn = funcV(o);
+    uint32_t i;
+    if (isluafunc(fn) && funcproto(fn)->firstline != ~(BCLine)0) {
+      TValue tv;
+      lj_buf_putb(sb, IMAGE_OBJ_LFUNC);
+      setprotoV(L, &tv, funcproto(fn));
+      image_putu(ctx, image_ref(ctx, &tv));
+      image_putu(ctx, image_reftab(ctx, tabref(fn->l.env)));
+      image_putu(ctx, fn->l.nupvalues);
+      for (i = 0; i < fn->l.nupvalues; i++) {
+	setgcV(L, &tv, gcref(fn->l.uvptr[i]), LJ_TUPVAL);
+	image_putu(ctx, image_ref(ctx, &tv));
+      }
+    } else {  /* C function or bytecode builtin. */
+      lj_buf_putb(sb, IMAGE_OBJ_CFUNC);
+      lj_buf_putb(sb, fn->c.ffid);
+      image_putu(ctx, fn->c.nupvalues);
+      image_putu(ctx, image_reftab(ctx, tabref(fn->c.env)));
+      for (i = 0; i < fn->c.nupvalues; i++)
+	image_putval(ctx, &fn->c.upvalue[i]);
+    }
+  } else if (tvisudata(o)) {
+    GCudata *ud = udataV(o);
+    lj_buf_putb(sb, IMAGE_OBJ_UDATA);
+    lj_buf_putb(sb, ud->udtype);
+    image_putu(ctx, image_reftab(ctx, tabref(ud->metatable)));
+    image_putu(ctx, image_reftab(ctx, tabref(ud->env)));
+  } else {
+    lj_assertL(itype(o) == LJ_TUPVAL, "bad image object type %d", itype(o));
+    lj_buf_putb(sb, IMAGE_OBJ_UPVAL);
+    image_putval(ctx, uvval(&gcV(o)->uv));
+  }
+}
+
+/* Mark all prototypes nested inside a prototype. */
+static void image_markinner(ImageCtx *ctx, GCtab *inner, GCproto *pt)
+{
+  lua_State *L = ctx->L;
+  ptrdiff_t i;
+  for (i = -1; i >= -(ptrdiff_t)pt->sizekgc; i--) {
+    GCobj *o = proto_kgc(pt, i);
+    if (o->gch.gct == ~LJ_TPROTO) {
+      TValue key, *tv;
+      setprotoV(L, &key, gco2pt(o));
+      tv = lj_tab_set(L, inner, &key);
+      if (tvisnil(tv)) {
+	setboolV(tv, 1);
+	lj_gc_anybarriert(L, inner);
+	image_markinner(ctx, inner, gco2pt(o));
+      }
+    }
+  }
+}
+
+/* Write the saved prototypes of a prototype tree in pre-order. */
+static uint32_t image_putprotos(ImageCtx *ctx, GCproto *pt, uint32_t dump,
+				uint32_t idx)
+{
+  TValue key;
+  cTValue *tv;
+  ptrdiff_t i;
+  setprotoV(ctx->L, &key, pt);
+  tv = lj_tab_get(ctx->L, ctx->ids, &key);
+  if (tvisnum(tv)) {
+    image_putu(ctx, (uint32_t)numV(tv));
+    lj_buf_putb(ctx->sb, IMAGE_OBJ_PROTO);
+    image_putu(ctx, dump);
+    image_putu(ctx, idx);
+  }
+  idx++;
+  for (i = -1; i >= -(ptrdiff_t)pt->sizekgc; i--) {
+    GCobj *o = proto_kgc(pt, i);
+    if (o->gch.gct == ~LJ_TPROTO)
+      idx = image_putprotos(ctx, gco2pt(o), dump, idx);
+  }
+  return idx;
+}
+
+static int image_wdump(lua_State *L, const void *p, size_t sz, void *ud)
+{
+  UNUSED(L);
+  lj_buf_putmem((SBuf *)ud, p, (MSize)sz);
+  return 0;
+}
+
+/* Dump each outermost saved prototype together with its inner ones. */
+static void image_dumpprotos(ImageCtx *ctx)
+{
+  lua_State *L = ctx->L;
+  SBuf *sb = ctx->sb;
+  GCtab *inner = lj_tab_new(L, 0, 0);
+  uint32_t i, n = ctx->nobj;
+  settabV(L, L->top, inner);  /* Anchor. */
+  incr_top(L);
+  for (i = 1; i <= n; i++) {
+    cTValue *o = lj_tab_getint(ctx->objs, (int32_t)i);
+    if (tvisproto(o))
+      image_markinner(ctx, inner, protoV(o));
+  }
+  for (i = 1; i <= n; i++) {
+    cTValue *o = lj_tab_getint(ctx->objs, (int32_t)i);
+    if (tvisproto(o) && tvisnil(lj_tab_get(L, inner, o))) {
+      GCproto *pt = protoV(o);
+      uint32_t dump = ++ctx->nobj;
+      MSize ofs, len, sz;
+      char tmp[5];
+      int status;
+      image_putu(ctx, dump);
+      lj_buf_putb(sb, IMAGE_OBJ_DUMP);
+      ofs = sbuflen(sb);
+      status = lj_bcwrite(L, pt, image_wdump, sb, 0);
+      if (status)
+	lj_err_throw(L, status);
+      /* Prepend the length of the dump. */
+      len = sbuflen(sb) - ofs;
+      sz = (MSize)(lj_strfmt_wuleb128(tmp, len) - tmp);
+      lj_buf_more(sb, sz);
+      memmove(sb->b + ofs + sz, sb->b + ofs, len);
+      memcpy(sb->b + ofs, tmp, sz);
+      sb->w += sz;
+      image_putprotos(ctx, pt, dump, 0);
+    }
+  }
+  L->top--;
+}
+
+/* Save a heap image. Returns the status of the writer. */
+int lj_image_save(lua_State *L, lua_Writer writer, void *data)
+{
+  global_State *g = G(L);
+  ImageCtx ctx;
+  uint32_t root[2+IMAGE_NBASEMT], i;
+  char hdr[4+1+5+5+(3+IMAGE_NBASEMT)*5], *w = hdr;
+  int status;
+  ctx.L = L;
+  ctx.sb = lj_buf_tmp_(L);  /* Assumes lj_bcwrite() doesn't use tmpbuf. */
+  ctx.nobj = 0;
+  ctx.ids = lj_tab_new(L, 0, 0);
+  settabV(L, L->top, ctx.ids);  /* Anchor. */
+  incr_top(L);
+  ctx.objs = lj_tab_new(L, 0, 0);
+  settabV(L, L->top, ctx.objs);  /* Anchor. */
+  incr_top(L);
+  root[0] = image_ref(&ctx, registry(L));
+  root[1] = image_reftab(&ctx, tabref(mainthread(g)->env));
+  for (i = 0; i < IMAGE_NBASEMT; i++)
+    root[2+i] = image_reftab(&ctx, tabref(g->gcroot[GCROOT_BASEMT+i]));
+  for (i = 1; i <= ctx.nobj; i++) {  /* Grows while objects are written. */
+    TValue o;
+    copyTV(L, &o, lj_tab_getint(ctx.objs, (int32_t)i));
+    if (!tvisproto(&o))
+      image_putobj(&ctx, i, &o);
+  }
+  image_dumpprotos(&ctx);
+  L->top -= 2;
+  memcpy(w, "\033LJI", 4); w += 4;
+  *w++ = IMAGE_VERSION;
+  w = lj_strfmt_wuleb128(w, LJ_BE ? IMAGE_F_BE : 0);
+  w = lj_strfmt_wuleb128(w, ctx.nobj);
+  w = lj_strfmt_wuleb128(w, root[0]);
+  w = lj_strfmt_wuleb128(w, root[1]);
+  w = lj_strfmt_wuleb128(w, IMAGE_NBASEMT);
+  for (i = 0; i < IMAGE_NBASEMT; i++)
+    w = lj_strfmt_wuleb128(w, root[2+i]);
+  status = writer(L, hdr, (size_t)(w - hdr), data);
+  if (!status)
+    status = writer(L, ctx.sb->b, sbuflen(ctx.sb), data);
+  return status;
+}
+
+/* -- Load heap image ----------------------------------------------------- */
+
+/* Object of a heap image being loaded. */
+typedef struct ImageObj {
+  const char *p;	/* Start of payload. */
+  uint32_t base;	/* Dump: index of first prototype. */
+  uint32_t count;	/* Dump: number of prototypes. */
+  uint8_t type;		/* Object type. */
+  uint8_t fresh;	/* Matched up with an object of the current state. */
+} ImageObj;
+
+/* State for loading a heap image. */
+typedef struct ImageState {
+  lua_State *L;
+  const char *pe;	/* End of image. */
+  ImageObj *obj;	/* Objects by id. */
+  uint32_t *queue;	/* Queue of matched objects. */
+  uint32_t nobj;	/* Number of objects. */
+  uint32_t nqueue;	/* Length of queue. */
+  GCtab *objs;		/* Id -> object, followed by loaded prototypes. */
+  GCtab *rev;		/* Matched object -> id. */
+} ImageState;
+
+static LJ_NORET LJ_NOINLINE void image_err(ImageState *st)
+{
+  lj_err_caller(st->L, LJ_ERR_IMGBAD);
+}
+
+static uint32_t image_rb(ImageState *st, const char **pp)
+{
+  if (*pp >= st->pe) image_err(st);
+  return *(const uint8_t *)(*pp)++;
+}
+
+static uint32_t image_ru(ImageState *st, const char **pp)
+{
+  uint32_t v = 0, sh = 0, b;
+  do {
+    if (sh > 28) image_err(st);
+    b = image_rb(st, pp);
+    v |= (b & 0x7f) << sh;
+    sh += 7;
+  } while (b >= 0x80);
+  return v;
+}
+
+static uint32_t image_rid(ImageState *st, const char **pp)
+{
+  uint32_t id = image_ru(st, pp);
+  if (id > st->nobj) image_err(st);
+  return id;
+}
+
+static cTValue *image_obj(ImageState *st, uint32_t id)
+{
+  cTValue *tv = lj_tab_getint(st->objs, (int32_t)id);
+  return tv ? tv : niltv(st->L);
+}
+
+static void image_setobj(ImageState *st, uint32_t id, cTValue *o)
+{
+  lua_State *L = st->L;
+  copyTV(L, lj_tab_setint(L, st->objs, (int32_t)id), o);
+  lj_gc_anybarriert(L, st->objs);
+}
+
+/* Read a value. Returns the id of a referenced object or 0. */
+static uint32_t image_getval(ImageState *st, const char **pp, TValue *o)
+{
+  uint32_t id;
+  switch (image_rb(st, pp)) {
+  case IMAGE_VAL_NIL: setnilV(o); return 0;
+  case IMAGE_VAL_FALSE: setboolV(o, 0); return 0;
+  case IMAGE_VAL_TRUE: setboolV(o, 1); return 0;
+  case IMAGE_VAL_INT: setintV(o, (int32_t)image_ru(st, pp)); return 0;
+  case IMAGE_VAL_NUM:
+    if (st->pe - *pp < 8) image_err(st);
+    memcpy(&o->u64, *pp, 8);
+    *pp += 8;
+    if (!tvisnum(o)) image_err(st);
+    return 0;
+  case IMAGE_VAL_REF:
+    id = image_rid(st, pp);
+    if (!id || st->obj[id].type > IMAGE_OBJ_UDATA) image_err(st);
+    copyTV(st->L, o, image_obj(st, id));
+    return id;
+  default:
+    image_err(st);
+    return 0;
+  }
+}
+
+static void image_skipval(ImageState *st, const char **pp)
+{
+  uint32_t tag = image_rb(st, pp);
+  if (tag == IMAGE_VAL_INT) {
+    image_ru(st, pp);
+  } else if (tag == IMAGE_VAL_NUM) {
+    if (st->pe - *pp < 8) image_err(st);
+    *pp += 8;
+  } else if (tag == IMAGE_VAL_REF) {
+    if (!image_rid(st, pp)) image_err(st);
+  } else if (tag > IMAGE_VAL_REF) {
+    image_err(st);
+  }
+}
+
+/* Record the type and payload of all objects. */
+static void image_scan(ImageState *st, const char *p)
+{
+  uint32_t i, n;
+  for (i = 0; i < st->nobj; i++) {
+    uint32_t id = image_rid(st, &p);
+    ImageObj *io = &st->obj[id];
+    if (!id || io->p) image_err(st);
+    io->type = (uint8_t)image_rb(st, &p);
+    io->p = p;
+    switch (io->type) {
+    case IMAGE_OBJ_STR: case IMAGE_OBJ_DUMP:
+      n = image_ru(st, &p);
+      if ((size_t)(st->pe - p) < n) image_err(st);
+      p += n;
+      break;
+    case IMAGE_OBJ_TAB:
+      image_ru(st, &p); image_ru(st, &p); image_rb(st, &p); image_rid(st, &p);
+      for (n = image_ru(st, &p); n; n--) {
+	image_skipval(st, &p);
+	image_skipval(st, &p);
+      }
+      break;
+    case IMAGE_OBJ_LFUNC:
+      image_rid(st, &p); image_rid(st, &p);
+      for (n = image_ru(st, &p); n; n--) image_rid(st, &p);
+      break;
+    case IMAGE_OBJ_CFUNC:
+      image_rb(st, &p);
+      n = image_ru(st, &p);
+      image_rid(st, &p);
+      for (; n; n--) image_skipval(st, &p);
+      break;
+    case IMAGE_OBJ_UDATA:
+      image_rb(st, &p); image_rid(st, &p); image_rid(st, &p);
+      break;
+    case IMAGE_OBJ_UPVAL:
+      image_skipval(st, &p);
+      break;
+    case IMAGE_OBJ_PROTO:
+      image_rid(st, &p); image_ru(st, &p);
+      break;
+    default:
+      image_err(st);
+    }
+  }
+  if (p != st->pe) image_err(st);
+}
+
+/* Require the preloaded modules of the image which aren't loaded yet. */
+static void image_preload(ImageState *st, uint32_t reg)
+{
+  lua_State *L = st->L;
+  GCstr *name = lj_str_newlit(L, "_LOADED");
+  const char *p = st->obj[reg].p;
+  uint32_t n, loaded = 0;
+  if (!reg || st->obj[reg].type != IMAGE_OBJ_TAB) return;
+  image_ru(st, &p); image_ru(st, &p); image_rb(st, &p); image_rid(st, &p);
+  for (n = image_ru(st, &p); n; n--) {
+    TValue key, val;
+    uint32_t id;
+    image_getval(st, &p, &key);
+    id = image_getval(st, &p, &val);
+    if (tvisstr(&key) && strV(&key) == name) loaded = id;
+  }
+  if (!loaded || st->obj[loaded].type != IMAGE_OBJ_TAB) return;
+  p = st->obj[loaded].p;
+  image_ru(st, &p); image_ru(st, &p); image_rb(st, &p); image_rid(st, &p);
+  lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+  lua_getfield(L, LUA_REGISTRYINDEX, "_PRELOAD");
+  if (tvistab(L->top-2) && tvistab(L->top-1)) {
+    for (n = image_ru(st, &p); n; n--) {
+      TValue key, val;
+      cTValue *tv;
+      image_getval(st, &p, &key);
+      image_getval(st, &p, &val);
+      if (!tvisstr(&key)) continue;
+      tv = lj_tab_getstr(tabV(L->top-2), strV(&key));
+      if (tv && !tvisnil(tv)) continue;
+      tv = lj_tab_getstr(tabV(L->top-1), strV(&key));
+      if (!tv || !tvisfunc(tv)) continue;
+      copyTV(L, L->top, tv);
+      incr_top(L);
+      setstrV(L, L->top, strV(&key));
+      incr_top(L);
+      lua_call(L, 1, 1);
+      if (tvisnil(L->top-1))
+	setboolV(L->top-1, 1);
+      setstrV(L, L->top, strV(&key));
+      incr_top(L);
+      lua_insert(L, -2);
+      lua_rawset(L, -4);
+    }
+  }
+  L->top -= 2;
+}
+
+/* Match up an image object with an object of the current state. */
+static void image_match(ImageState *st, uint32_t id, cTValue *o)
+{
+  lua_State *L = st->L;
+  ImageObj *io = &st->obj[id];
+  const char *p = io->p;
+  if (!id || io->fresh || !tvisgcv(o) || !tvisnil(lj_tab_get(L, st->rev, o)))
+    return;
+  switch (io->type) {
+  case IMAGE_OBJ_TAB:
+    if (!tvistab(o) || isfrozen(gcV(o))) return;
+    break;
+  case IMAGE_OBJ_CFUNC:
+    if (!tvisfunc(o) || funcV(o)->c.ffid != image_rb(st, &p) ||
+	(isluafunc(funcV(o)) && funcproto(funcV(o))->firstline != ~(BCLine)0) ||
+	funcV(o)->c.nupvalues != image_ru(st, &p))
+      return;
+    break;
+  case IMAGE_OBJ_UDATA:
+    if (!tvisudata(o) || udataV(o)->udtype != image_rb(st, &p)) return;
+    break;
+  default:
+    return;
+  }
+  io->fresh = 1;
+  image_setobj(st, id, o);
+  setnumV(lj_tab_set(L, st->rev, o), (lua_Number)id);
+  lj_gc_anybarriert(L, st->rev);
+  st->queue[st->nqueue++] = id;
+}
+
+static void image_matchtab(ImageState *st, uint32_t id, GCtab *t)
+{
+  if (t) {
+    TValue tv;
+    settabV(st->L, &tv, t);
+    image_match(st, id, &tv);
+  }
+}
+
+/* Follow the same keys, metatables, environments and upvalues in both. */
+static void image_matchall(ImageState *st)
+{
+  lua_State *L = st->L;
+  uint32_t q, i, n;
+  for (q = 0; q < st->nqueue; q++) {
+    uint32_t id = st->queue[q];
+    const char *p = st->obj[id].p;
+    TValue tv;
+    copyTV(L, &tv, image_obj(st, id));
+    if (tvistab(&tv)) {
+      GCtab *t = tabV(&tv);
+      image_ru(st, &p); image_ru(st, &p); image_rb(st, &p);
+      image_matchtab(st, image_rid(st, &p), tabref(t->metatable));
+      for (n = image_ru(st, &p); n; n--) {
+	TValue key, val;
+	uint32_t vid;
+	image_getval(st, &p, &key);
+	vid = image_getval(st, &p, &val);
+	if (vid && !tvisnil(&key) && (tvisstr(&key) || !tvisgcv(&key)))
+	  image_match(st, vid, lj_tab_get(L, t, &key));
+      }
+    } else if (tvisfunc(&tv)) {
+      GCfunc *fn = funcV(&tv);
+      image_rb(st, &p);
+      n = image_ru(st, &p);
+      image_matchtab(st, image_rid(st, &p), tabref(fn->c.env));
+      for (i = 0; i < n; i++) {
+	TValue val;
+	uint32_t vid = image_getval(st, &p, &val);
+	if (vid) image_match(st, vid, &fn->c.upvalue[i]);
+      }
+    } else {
+      GCudata *ud = udataV(&tv);
+      image_rb(st, &p);
+      image_matchtab(st, image_rid(st, &p), tabref(ud->metatable));
+      image_matchtab(st, image_rid(st, &p), tabref(ud->env));
+    }
+  }
+}
+
+/* Number the prototypes of a loaded dump in pre-order. */
+static uint32_t image_protos(ImageState *st, GCproto *pt, uint32_t idx)
+{
+  TValue tv;
+  ptrdiff_t i;
+  setprotoV(st->L, &tv, pt);
+  image_setobj(st, st->nobj+1+idx, &tv);
+  idx++;
+  for (i = -1; i >= -(ptrdiff_t)pt->sizekgc; i--) {
+    GCobj *o = proto_kgc(pt, i);
+    if (o->gch.gct == ~LJ_TPROTO)
+      idx = image_protos(st, gco2pt(o), idx);
+  }
+  return idx;
+}
+
+/* Create all objects which haven't been matched up. */
+static void image_create(ImageState *st)
+{
+  lua_State *L = st->L;
+  uint32_t id, nproto = 0;
+  for (id = 1; id <= st->nobj; id++) {
+    ImageObj *io = &st->obj[id];
+    const char *p = io->p;
+    TValue tv;
+    if (io->fresh) continue;
+    if (io->type == IMAGE_OBJ_TAB) {
+      uint32_t asize = image_ru(st, &p), hbits = image_ru(st, &p);
+      if (asize > LJ_MAX_ASIZE || hbits > LJ_MAX_HBITS) image_err(st);
+      settabV(L, &tv, lj_tab_new(L, asize, hbits));
+      image_setobj(st, id, &tv);
+    } else if (io->type == IMAGE_OBJ_CFUNC || io->type == IMAGE_OBJ_UDATA) {
+      lj_err_callerv(L, LJ_ERR_IMGNOBJ,
+		     io->type == IMAGE_OBJ_CFUNC ? "C function" : "userdata");
+    } else if (io->type == IMAGE_OBJ_DUMP) {
+      MSize len = image_ru(st, &p);
+      if (luaL_loadbufferx(L, p, len, "=image", "b"))
+	lua_error(L);
+      io->base = nproto;
+      nproto = image_protos(st, funcproto(funcV(L->top-1)), nproto);
+      io->count = nproto - io->base;
+      L->top--;
+    }
+  }
+  for (id = 1; id <= st->nobj; id++) {
+    ImageObj *io = &st->obj[id];
+    const char *p = io->p;
+    if (io->type == IMAGE_OBJ_PROTO) {
+      ImageObj *dump = &st->obj[image_rid(st, &p)];
+      uint32_t idx = image_ru(st, &p);
+      if (dump->type != IMAGE_OBJ_DUMP || idx >= dump->count) image_err(st);
+      image_setobj(st, id, image_obj(st, st->nobj+1+dump->base+idx));
+    }
+  }
+  for (id = 1; id <= st->nobj; id++) {
+    ImageObj *io = &st->obj[id];
+    const char *p = io->p;
+    if (io->type == IMAGE_OBJ_LFUNC) {
+      cTValue *pv = image_obj(st, image_rid(st, &p));
+      cTValue *ev = image_obj(st, image_rid(st, &p));
+      GCproto *pt;
+      GCfunc *fn;
+      TValue tv;
+      uint32_t i, n = image_ru(st, &p);
+      if (!tvisproto(pv) || !tvistab(ev)) image_err(st);
+      pt = protoV(pv);
+      if (n != pt->sizeuv) image_err(st);
+      fn = lj_func_newL_empty(L, pt, tabV(ev));
+      setfuncV(L, &tv, fn);
+      image_setobj(st, id, &tv);
+      for (i = 0; i < n; i++) {
+	uint32_t uid = image_rid(st, &p);
+	cTValue *uv;
+	if (st->obj[uid].type != IMAGE_OBJ_UPVAL) image_err(st);
+	uv = image_obj(st, uid);
+	if (tvisnil(uv)) {  /* First user keeps its new upvalue. */
+	  setgcV(L, &tv, gcref(fn->l.uvptr[i]), LJ_TUPVAL);
+	  image_setobj(st, uid, &tv);
+	} else {
+	  setgcref(fn->l.uvptr[i], gcV(uv));
+	  lj_gc_objbarrier(L, fn, gcV(uv));
+	}
+      }
+    }
+  }
+}
+
+/* Fill in tables and upvalues. Matched tables lose their old contents. */
+static void image_fill(ImageState *st)
+{
+  lua_State *L = st->L;
+  uint32_t id, n;
+  for (id = 1; id <= st->nobj; id++) {
+    ImageObj *io = &st->obj[id];
+    const char *p = io->p;
+    if (io->type == IMAGE_OBJ_TAB) {
+      GCtab *t = tabV(image_obj(st, id)), *mt = NULL;
+      uint32_t mid;
+      image_ru(st, &p); image_ru(st, &p); image_rb(st, &p);
+      if ((mid = image_rid(st, &p))) {
+	cTValue *mv = image_obj(st, mid);
+	if (!tvistab(mv)) image_err(st);
+	mt = tabV(mv);
+      }
+      if (io->fresh) lj_tab_clear(t);
+      setgcref(t->metatable, obj2gco(mt));
+      for (n = image_ru(st, &p); n; n--) {
+	TValue key, val;
+	image_getval(st, &p, &key);
+	image_getval(st, &p, &val);
+	if (tvisnil(&key) || tvisnil(&val)) image_err(st);
+	copyTV(L, lj_tab_set(L, t, &key), &val);
+      }
+      t->nomm = 0;  /* Invalidate metamethod cache. */
+      lj_gc_anybarriert(L, t);
+    } else if (io->type == IMAGE_OBJ_UPVAL) {
+      cTValue *tv = image_obj(st, id);
+      if (!tvisnil(tv)) {
+	GCupval *uv = &gcV(tv)->uv;
+	image_getval(st, &p, uvval(uv));
+	lj_gc_barrier(L, uv, uvval(uv));
+      }
+    }
+  }
+  for (id = 1; id <= st->nobj; id++) {
+    ImageObj *io = &st->obj[id];
+    const char *p = io->p;
+    if (io->type == IMAGE_OBJ_TAB) {
+      image_ru(st, &p); image_ru(st, &p);
+      if ((image_rb(st, &p) & IMAGE_TAB_FROZEN))
+	lj_gc_freeze(L, tabV(image_obj(st, id)));
+    }
+  }
+}
+
+/* Load a heap image into the current state. */
+void lj_image_load(lua_State *L, const char *p, size_t len)
+{
+  global_State *g = G(L);
+  ImageState st;
+  uint32_t root[2+IMAGE_NBASEMT], i;
+  GCudata *ud;
+  MSize sz;
+  st.L = L;
+  st.pe = p + len;
+  st.nobj = 0;
+  st.nqueue = 0;
+  if (len < 5 || memcmp(p, "\033LJI", 4)) image_err(&st);
+  p += 4;
+  if (image_rb(&st, &p) != IMAGE_VERSION ||
+      image_ru(&st, &p) != (LJ_BE ? IMAGE_F_BE : 0))
+    lj_err_caller(L, LJ_ERR_IMGFMT);
+  st.nobj = image_ru(&st, &p);
+  if (st.nobj > len ||
+      st.nobj >= LJ_MAX_UDATA / (sizeof(ImageObj) + sizeof(uint32_t)))
+    image_err(&st);
+  root[0] = image_rid(&st, &p);
+  root[1] = image_rid(&st, &p);
+  if (image_ru(&st, &p) != IMAGE_NBASEMT) image_err(&st);
+  for (i = 0; i < IMAGE_NBASEMT; i++)
+    root[2+i] = image_rid(&st, &p);
+  sz = (st.nobj+1) * (MSize)(sizeof(ImageObj) + sizeof(uint32_t));
+  ud = lj_udata_new(L, sz, tabref(L->env));
+  setudataV(L, L->top, ud);  /* Anchor. */
+  incr_top(L);
+  memset(uddata(ud), 0, sz);
+  st.obj = (ImageObj *)uddata(ud);
+  st.queue = (uint32_t *)(st.obj + st.nobj+1);
+  st.objs = lj_tab_new(L, st.nobj+1, 0);
+  settabV(L, L->top, st.objs);  /* Anchor. */
+  incr_top(L);
+  st.rev = lj_tab_new(L, 0, 0);
+  settabV(L, L->top, st.rev);  /* Anchor. */
+  incr_top(L);
+  image_scan(&st, p);
+  for (i = 1; i <= st.nobj; i++) {  /* Strings are needed for matching. */
+    const char *q = st.obj[i].p;
+    if (st.obj[i].type == IMAGE_OBJ_STR) {
+      TValue tv;
+      MSize n = image_ru(&st, &q);
+      setstrV(L, &tv, lj_str_new(L, q, n));
+      image_setobj(&st, i, &tv);
+    }
+  }
+  image_preload(&st, root[0]);
+  image_match(&st, root[0], registry(L));
+  image_matchtab(&st, root[1], tabref(mainthread(g)->env));
+  for (i = 0; i < IMAGE_NBASEMT; i++)
+    image_matchtab(&st, root[2+i], tabref(g->gcroot[GCROOT_BASEMT+i]));
+  if (!root[0] || !st.obj[root[0]].fresh || !root[1] || !st.obj[root[1]].fresh)
+    image_err(&st);
+  image_matchall(&st);
+  image_create(&st);
+  image_fill(&st);
+  for (i = 0; i < IMAGE_NBASEMT; i++) {
+    if (root[2+i]) {
+      cTValue *mv = image_obj(&st, root[2+i]);
+      if (!tvistab(mv)) image_err(&st);
+      if (tabref(g->gcroot[GCROOT_BASEMT+i]) != tabV(mv)) {
+	lj_trace_flushall(L);  /* Traces specialize to basemt. */
+	/* NOBARRIER: basemt is a GC root. */
+	setgcref(g->gcroot[GCROOT_BASEMT+i], gcV(mv));
+      }
+    }
+  }
+  L->top -= 3;
+}
@@ -0,0 +1,14 @@
+/*
+** Heap images.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#ifndef _LJ_IMAGE_H
+#define _LJ_IMAGE_H
+
+#include "lj_obj.h"
+
+LJ_FUNC int lj_image_save(lua_State *L, lua_Writer writer, void *data);
+LJ_FUNC void lj_image_load(lua_State *L, const char *p, size_t len);
+
+#endif
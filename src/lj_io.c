@@ -0,0 +1,196 @@
+/*
+** File input helpers.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+**
+** Lines are read with fgets() straight into the free space of a string
+** buffer. fgets() scans the stdio buffer with memchr(), which is about as
+** fast as newline scanning gets. Files opened with io.open(name, "rm")
+** are read from a memory mapping instead, without any stdio copies.
+** These functions are called from the I/O library and from JIT-compiled
+** code.
+*/
+
+#define lj_io_c
+#define LUA_CORE
+
+#include "lj_obj.h"
+
+#if LJ_TARGET_POSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+#include "lj_gc.h"
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_str.h"
+#include "lj_io.h"
+
+#define IO_LINEMIN	128	/* Min. free space for each fgets() call. */
+
+/* Append the next line to a buffer. Returns 0 if nothing could be read. */
+int lj_io_getline(SBuf *sb, FILE *fp, int chop)
+{
+  int ok = 0;
+  for (;;) {
+    char *w = lj_buf_more(sb, IO_LINEMIN);
+    MSize n;
+    if (fgets(w, (int)sbufleft(sb), fp) == NULL) break;
+    n = (MSize)strlen(w);
+    sb->w = w + n;
+    ok = 1;
+    if (n && w[n-1] == '\n') { sb->w -= chop; break; }
+  }
+  return ok;
+}
+
+/* Get the next line from the mapping. Returns NULL at the end. */
+const char *lj_io_mapline(IOFileUD *iof, size_t *lenp, int chop)
+{
+  const char *p = iof->map + iof->mappos, *q;
+  size_t n;
+  if (iof->mappos >= iof->mapsz) return NULL;
+  n = iof->mapsz - iof->mappos;
+  q = (const char *)memchr(p, '\n', n);
+  if (q) n = (size_t)(q - p) + 1;
+  iof->mappos += n;
+  *lenp = n - (q && chop);
+  return p;
+}
+
+/* Check whether the next read returns nothing. Doesn't consume input. */
+int lj_io_ateof(IOFileUD *iof)
+{
+  int c;
+  if ((iof->type & IOFILE_FLAG_MAP))
+    return iof->mappos >= iof->mapsz;
+  if (!iof->fp || (c = getc(iof->fp)) == EOF)
+    return 1;
+  ungetc(c, iof->fp);
+  return 0;
+}
+
+/* Read the next line as a string. Returns NULL at the end of the file. */
+GCstr *lj_io_readline(lua_State *L, IOFileUD *iof, int32_t chop)
+{
+  SBuf *sb;
+  if ((iof->type & IOFILE_FLAG_MAP)) {
+    size_t len;
+    const char *p = lj_io_mapline(iof, &len, chop);
+    return p ? lj_str_new(L, p, len) : NULL;
+  }
+  sb = lj_buf_tmp_(L);
+  if (!lj_io_getline(sb, iof->fp, chop)) return NULL;
+  return lj_str_new(L, sb->b, sbuflen(sb));
+}
+
+#if LJ_HASBUFFER
+/* Turn a buffer object into a read-only view of the mapping. */
+void lj_io_mapview(lua_State *L, SBufExt *sbx, IOFileUD *iof,
+		   const char *p, size_t len)
+{
+  GCudata *ud = (GCudata *)iof - 1;
+  if (len > LJ_MAX_BUF)
+    lj_err_mem(L);
+  lj_bufx_free(L, sbx);
+  lj_bufx_set_cow(L, sbx, p, (MSize)len);
+  setgcref(sbx->cowref, obj2gco(ud));  /* Keeps the mapping alive. */
+  lj_gc_objbarrier(L, (GCudata *)sbx - 1, ud);
+}
+
+/* Replace the contents of a buffer object with the next line. */
+int lj_io_readline_buf(lua_State *L, SBufExt *sbx, IOFileUD *iof,
+		       int32_t chop)
+{
+  setsbufXL_(sbx, L);
+  if ((iof->type & IOFILE_FLAG_MAP)) {
+    size_t len;
+    const char *p = lj_io_mapline(iof, &len, chop);
+    if (!p) {
+      lj_bufx_reset(sbx);
+      return 0;
+    }
+    lj_io_mapview(L, sbx, iof, p, len);
+    return 1;
+  }
+  lj_bufx_reset(sbx);
+  return lj_io_getline((SBuf *)sbx, iof->fp, chop);
+}
+#endif
+
+/* -- io.lines() iterator traces ------------------------------------------ */
+
+/* Get the kind of an io.lines() iterator. Returns -1 if it isn't compiled. */
+int lj_io_lineskind(GCfunc *fn)
+{
+  cTValue *o = &fn->c.upvalue[1];
+  if (fn->c.nupvalues == 1) return IOLINES_CHOP;
+  if (fn->c.nupvalues > 2) return -1;
+  if (tvisstr(o)) {
+    const char *p = strVdata(o);
+    if (p[0] == '*') p++;
+    if (p[0] == 'l') return IOLINES_CHOP;
+    if (p[0] == 'L') return IOLINES_KEEP;
+  }
+#if LJ_HASBUFFER
+  if (tvisbuf(o)) return IOLINES_BUF;
+#endif
+  return -1;
+}
+
+/* Read the next line for a trace. The iterator is passed along, since each
+** io.lines() call creates a new one. Returns NULL at the end of the file,
+** for a closed file or for another kind of iterator. The trace exits then.
+*/
+GCstr *lj_io_linesnext(lua_State *L, GCfunc *fn, int32_t kind)
+{
+  IOFileUD *iof = (IOFileUD *)uddata(udataV(&fn->c.upvalue[0]));
+  if (iof->fp == NULL || lj_io_lineskind(fn) != kind) return NULL;
+  return lj_io_readline(L, iof, kind == IOLINES_CHOP);
+}
+
+#if LJ_HASBUFFER
+/* Read the next line into the buffer object of the iterator for a trace.
+** Returns the buffer object or NULL, like lj_io_linesnext().
+*/
+GCudata *lj_io_linesnext_buf(lua_State *L, GCfunc *fn)
+{
+  IOFileUD *iof = (IOFileUD *)uddata(udataV(&fn->c.upvalue[0]));
+  GCudata *ud;
+  if (iof->fp == NULL || lj_io_lineskind(fn) != IOLINES_BUF) return NULL;
+  ud = udataV(&fn->c.upvalue[1]);
+  return lj_io_readline_buf(L, (SBufExt *)uddata(ud), iof, 1) ? ud : NULL;
+}
+#endif
+
+#if LJ_TARGET_POSIX
+/* Map a regular file opened for reading. Returns 0 if this isn't possible. */
+int lj_io_map(IOFileUD *iof)
+{
+  struct stat st;
+  void *p;
+  /* Files of size 0 use stdio, too, e.g. in procfs or sysfs. */
+  if (fstat(fileno(iof->fp), &st) != 0 || !S_ISREG(st.st_mode) ||
+      st.st_size == 0 || (uint64_t)st.st_size > (uint64_t)(~(size_t)0 >> 1))
+    return 0;
+  p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+	   fileno(iof->fp), 0);
+  if (p == MAP_FAILED) return 0;
+#ifdef MADV_SEQUENTIAL
+  madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+  iof->map = (char *)p;
+  iof->mapsz = (size_t)st.st_size;
+  iof->mappos = 0;
+  iof->type |= IOFILE_FLAG_MAP;
+  return 1;
+}
+
+void lj_io_unmap(IOFileUD *iof)
+{
+  if (iof->map) munmap(iof->map, iof->mapsz);
+  iof->map = NULL;
+  iof->mapsz = iof->mappos = 0;
+}
+#endif
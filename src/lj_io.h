@@ -0,0 +1,56 @@
+/*
+** File input helpers.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#ifndef _LJ_IO_H
+#define _LJ_IO_H
+
+#include <stdio.h>
+
+#include "lj_obj.h"
+#include "lj_buf.h"
+
+/* Userdata payload for I/O file. */
+typedef struct IOFileUD {
+  FILE *fp;		/* File handle. */
+  uint32_t type;	/* File type. */
+  char *map;		/* Memory-mapped file contents or NULL. */
+  size_t mapsz;		/* Size of the mapping. */
+  size_t mappos;	/* Read position in the mapping. */
+} IOFileUD;
+
+#define IOFILE_TYPE_FILE	0	/* Regular file. */
+#define IOFILE_TYPE_PIPE	1	/* Pipe. */
+#define IOFILE_TYPE_STDF	2	/* Standard file handle. */
+#define IOFILE_TYPE_MASK	3
+
+#define IOFILE_FLAG_CLOSE	4	/* Close after io.lines() iterator. */
+#define IOFILE_FLAG_MAP		8	/* Reads come from the mapping. */
+
+#define LJ_IO_LINESBUF	65536	/* Size of the stdio buffer for io.lines(). */
+
+/* Kinds of compiled io.lines() iterators. */
+#define IOLINES_KEEP		0	/* "L" format. */
+#define IOLINES_CHOP		1	/* No format or "l". */
+#define IOLINES_BUF		2	/* Buffer object. */
+
+LJ_FUNC int lj_io_getline(SBuf *sb, FILE *fp, int chop);
+LJ_FUNC const char *lj_io_mapline(IOFileUD *iof, size_t *lenp, int chop);
+LJ_FUNC int lj_io_ateof(IOFileUD *iof);
+LJ_FUNC GCstr *lj_io_readline(lua_State *L, IOFileUD *iof, int32_t chop);
+LJ_FUNC int lj_io_lineskind(GCfunc *fn);
+LJ_FUNC GCstr *lj_io_linesnext(lua_State *L, GCfunc *fn, int32_t kind);
+#if LJ_HASBUFFER
+LJ_FUNC GCudata *lj_io_linesnext_buf(lua_State *L, GCfunc *fn);
+LJ_FUNC void lj_io_mapview(lua_State *L, SBufExt *sbx, IOFileUD *iof,
+			   const char *p, size_t len);
+LJ_FUNC int lj_io_readline_buf(lua_State *L, SBufExt *sbx, IOFileUD *iof,
+			       int32_t chop);
+#endif
+#if LJ_TARGET_POSIX
+LJ_FUNC int lj_io_map(IOFileUD *iof);
+LJ_FUNC void lj_io_unmap(IOFileUD *iof);
+#endif
+
+#endif
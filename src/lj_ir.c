@@ -32,6 +32,8 @@
 #include "lj_vm.h"
 #include "lj_strscan.h"
 #include "lj_serialize.h"
+#include "lj_json.h"
+#include "lj_io.h"
 #include "lj_strfmt.h"
 #include "lj_prng.h"
 
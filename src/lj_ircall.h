@@ -182,11 +182,15 @@ typedef struct CCallInfo {
   _(BUFFER,	lj_serialize_get,	2,  FS, PTR, CCI_T) \
   _(BUFFER,	lj_serialize_encode,	2,  FA, STR, CCI_L|CCI_T) \
   _(BUFFER,	lj_serialize_decode,	3,   A, INT, CCI_L|CCI_T) \
+  _(BUFFER,	lj_json_put,		2,  FS, PGC, CCI_T) \
+  _(BUFFER,	lj_json_get,		2,  FS, PTR, CCI_T) \
+  _(BUFFER,	lj_io_linesnext_buf,	2,   A, UDATA, CCI_L|CCI_T) \
   _(ANY,	lj_buf_tostr,		1,  FL, STR, CCI_T) \
   _(ANY,	lj_tab_new_ah,		3,   A, TAB, CCI_L|CCI_T) \
   _(ANY,	lj_tab_new1,		2,  FA, TAB, CCI_L|CCI_T) \
   _(ANY,	lj_tab_dup,		2,  FA, TAB, CCI_L|CCI_T) \
   _(ANY,	lj_tab_clear,		1,  FS, NIL, 0) \
+  _(ANY,	lj_tab_move,		6,   S, NIL, CCI_L) \
   _(ANY,	lj_tab_newkey,		3,   S, PGC, CCI_L|CCI_T) \
   _(ANY,	lj_tab_keyindex,	2,  FL, INT, 0) \
   _(ANY,	lj_vm_next,		2,  FL, PTR, 0) \
@@ -211,6 +215,7 @@ typedef struct CCallInfo {
   _(ANY,	fputc,			2,   S, INT, 0) \
   _(ANY,	fwrite,			4,   S, INT, 0) \
   _(ANY,	fflush,			1,   S, INT, 0) \
+  _(ANY,	lj_io_linesnext,	3,   A, STR, CCI_L|CCI_T) \
   /* ORDER FPM */ \
   _(FPMATH,	lj_vm_floor,		1,   N, NUM, XA_FP) \
   _(FPMATH,	lj_vm_ceil,		1,   N, NUM, XA_FP) \
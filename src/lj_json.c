@@ -0,0 +1,580 @@
+/*
+** JSON encoding and decoding.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#define lj_json_c
+#define LUA_CORE
+
+#include "lj_obj.h"
+
+#if LJ_HASBUFFER
+#include "lj_err.h"
+#include "lj_buf.h"
+#include "lj_str.h"
+#include "lj_tab.h"
+#include "lj_udata.h"
+#include "lj_char.h"
+#include "lj_strscan.h"
+#include "lj_strfmt.h"
+#if LJ_HASJIT
+#include "lj_ir.h"
+#endif
+#include "lj_serialize.h"
+#include "lj_json.h"
+
+/* Shortest format that always round-trips a double. */
+#define JSON_G17	(STRFMT_G | ((17+1) << STRFMT_SH_PREC))
+
+/* Number of cached object keys per decode. Must be a power of 2. */
+#define JSON_KCACHE	64
+
+/* -- Helper functions ---------------------------------------------------- */
+
+/* Scan 8 bytes at a time for bytes that end a plain run of a string. */
+#define JSON_ONES	U64x(01010101,01010101)
+#define JSON_HIGHS	U64x(80808080,80808080)
+#define json_hasbyte(x, c) \
+  ((((x) ^ (JSON_ONES*(c))) - JSON_ONES) & ~((x) ^ (JSON_ONES*(c))))
+
+static LJ_AINLINE uint64_t json_ru64(const char *p)
+{
+  uint64_t x;
+  memcpy(&x, p, 8);
+  return x;
+}
+
+/* Any '"' or '\\'? */
+static LJ_AINLINE uint64_t json_quote(uint64_t x)
+{
+  return (json_hasbyte(x, '"') | json_hasbyte(x, '\\')) & JSON_HIGHS;
+}
+
+/* Any '"', '\\' or control character? */
+static LJ_AINLINE uint64_t json_special(uint64_t x)
+{
+  return (json_hasbyte(x, '"') | json_hasbyte(x, '\\') |
+	  ((x - JSON_ONES*0x20) & ~x)) & JSON_HIGHS;
+}
+
+#define json_isspecial(c)	((c) < 0x20 || (c) == '"' || (c) == '\\')
+
+static LJ_AINLINE const char *json_skipws(const char *p, const char *e)
+{
+  while (p < e && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+  return p;
+}
+
+/* -- Encoder ------------------------------------------------------------- */
+
+/* Ensure a certain amount of buffer space. */
+static LJ_AINLINE char *json_more(char *w, SBufExt *sbx, MSize sz)
+{
+  if (LJ_UNLIKELY(sz > (MSize)(sbx->e - w))) {
+    sbx->w = w;
+    w = lj_buf_more2((SBuf *)sbx, sz);
+  }
+  return w;
+}
+
+static char *json_putstr(char *w, SBufExt *sbx, const char *p, MSize len)
+{
+  const char *pe = p + len;
+  w = json_more(w, sbx, 1);
+  *w++ = '"';
+  for (;;) {
+    const char *q = p;
+    uint32_t c;
+    while (pe - q >= 8 && !json_special(json_ru64(q))) q += 8;
+    while (q < pe && !json_isspecial((uint8_t)*q)) q++;
+    w = json_more(w, sbx, (MSize)(q - p) + 7);
+    memcpy(w, p, (size_t)(q - p)); w += q - p;
+    if (q == pe) break;
+    c = (uint8_t)*q;
+    *w++ = '\\';
+    switch (c) {
+    case '"': case '\\': *w++ = (char)c; break;
+    case '\b': *w++ = 'b'; break;
+    case '\f': *w++ = 'f'; break;
+    case '\n': *w++ = 'n'; break;
+    case '\r': *w++ = 'r'; break;
+    case '\t': *w++ = 't'; break;
+    default:
+      *w++ = 'u'; *w++ = '0'; *w++ = '0';
+      *w++ = "0123456789abcdef"[c >> 4]; *w++ = "0123456789abcdef"[c & 15];
+      break;
+    }
+    p = q+1;
+  }
+  *w++ = '"';
+  return w;
+}
+
+static char *json_putnum(char *w, SBufExt *sbx, cTValue *o)
+{
+  lua_Number n = numV(o);
+  int32_t k = lj_num2int(n);
+  MSize ofs;
+  TValue tv;
+  if (n == (lua_Number)k) {
+    w = json_more(w, sbx, STRFMT_MAXBUF_INT);
+    return lj_strfmt_wint(w, k);
+  }
+  if (!(n - n == 0))  /* NaN or infinity. */
+    lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADENC, lj_typename(o));
+  /* Use %.14g, unless it loses precision. Compaction only moves sbx->r. */
+  sbx->w = w;
+  ofs = (MSize)(w - sbx->r);
+  lj_strfmt_putfnum((SBuf *)sbx, STRFMT_G14, n);
+  *lj_buf_more((SBuf *)sbx, 1) = '\0';
+  if (lj_strscan_scan((const uint8_t *)sbx->r + ofs, sbufxlen(sbx) - ofs, &tv,
+		      STRSCAN_OPT_TONUM) != STRSCAN_NUM || tv.n != n) {
+    sbx->w = sbx->r + ofs;
+    lj_strfmt_putfnum((SBuf *)sbx, JSON_G17, n);
+  }
+  return sbx->w;
+}
+
+/* Get the length of a table, if it's a proper array. Otherwise return 0. */
+static MSize json_arraylen(GCtab *t)
+{
+  MSize n = 0, nmax = 0, i;
+  if (t->asize > 0) {
+    TValue *array = tvref(t->array);
+    if (!tvisnil(&array[0])) return 0;
+    for (i = 1; i < t->asize; i++)
+      if (!tvisnil(&array[i])) { n++; nmax = i; }
+  }
+  if (t->hmask > 0) {
+    Node *node = noderef(t->node);
+    for (i = 0; i <= t->hmask; i++) {
+      cTValue *key = &node[i].key;
+      lua_Number k;
+      if (tvisnil(&node[i].val)) continue;
+      if (tvisint(key)) k = (lua_Number)intV(key);
+      else if (tvisnum(key)) k = numV(key);
+      else return 0;
+      if (!(k >= 1 && k <= LJ_MAX_ASIZE && k == (lua_Number)(MSize)k))
+	return 0;
+      n++;
+      if ((MSize)k > nmax) nmax = (MSize)k;
+    }
+  }
+  return n == nmax ? n : 0;
+}
+
+static char *json_put(char *w, SBufExt *sbx, cTValue *o);
+
+/* Write a key-value pair of an object. */
+static char *json_putpair(char *w, SBufExt *sbx, cTValue *key, cTValue *val,
+			  int first)
+{
+  if (!first) {
+    w = json_more(w, sbx, 1);
+    *w++ = ',';
+  }
+  if (tvisstr(key)) {
+    w = json_putstr(w, sbx, strdata(strV(key)), strV(key)->len);
+  } else if (tvisnumber(key)) {
+    w = json_more(w, sbx, 1);
+    *w++ = '"';
+    w = tvisint(key) ? lj_strfmt_wint(json_more(w, sbx, STRFMT_MAXBUF_INT),
+				      intV(key)) : json_putnum(w, sbx, key);
+    w = json_more(w, sbx, 1);
+    *w++ = '"';
+  } else {
+    lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADENC, lj_typename(key));
+  }
+  w = json_more(w, sbx, 1);
+  *w++ = ':';
+  return json_put(w, sbx, val);
+}
+
+static char *json_put(char *w, SBufExt *sbx, cTValue *o)
+{
+  if (LJ_LIKELY(tvisstr(o))) {
+    w = json_putstr(w, sbx, strdata(strV(o)), strV(o)->len);
+  } else if (tvisint(o)) {
+    w = json_more(w, sbx, STRFMT_MAXBUF_INT);
+    w = lj_strfmt_wint(w, intV(o));
+  } else if (tvisnum(o)) {
+    w = json_putnum(w, sbx, o);
+  } else if (tvistab(o)) {
+    GCtab *t = tabV(o);
+    MSize n;
+    if (sbx->depth <= 0) lj_err_caller(sbufL(sbx), LJ_ERR_BUFFER_DEPTH);
+    sbx->depth--;
+    n = json_arraylen(t);
+    if (n) {
+      MSize i;
+      w = json_more(w, sbx, 1);
+      *w++ = '[';
+      for (i = 1; i <= n; i++) {
+	cTValue *v = lj_tab_getint(t, (int32_t)i);
+	if (i > 1) {
+	  w = json_more(w, sbx, 1);
+	  *w++ = ',';
+	}
+	w = json_put(w, sbx, v);
+      }
+      w = json_more(w, sbx, 1);
+      *w++ = ']';
+    } else {
+      int first = 1;
+      MSize i;
+      w = json_more(w, sbx, 1);
+      *w++ = '{';
+      for (i = 1; i < t->asize; i++) {
+	cTValue *v = arrayslot(t, i);
+	if (!tvisnil(v)) {
+	  TValue key;
+	  setintV(&key, (int32_t)i);
+	  w = json_putpair(w, sbx, &key, v, first);
+	  first = 0;
+	}
+      }
+      if (t->asize > 0 && !tvisnil(arrayslot(t, 0))) {
+	TValue key;
+	setintV(&key, 0);
+	w = json_putpair(w, sbx, &key, arrayslot(t, 0), first);
+	first = 0;
+      }
+      if (t->hmask > 0) {
+	Node *node = noderef(t->node);
+	for (i = 0; i <= t->hmask; i++)
+	  if (!tvisnil(&node[i].val)) {
+	    w = json_putpair(w, sbx, &node[i].key, &node[i].val, first);
+	    first = 0;
+	  }
+      }
+      w = json_more(w, sbx, 1);
+      *w++ = '}';
+    }
+    sbx->depth++;
+  } else if (tvisnil(o) ||
+	     (tvislightud(o) && !lightudV(G(sbufL(sbx)), o))) {
+    w = json_more(w, sbx, 4);
+    memcpy(w, "null", 4); w += 4;
+  } else if (tvistrue(o)) {
+    w = json_more(w, sbx, 4);
+    memcpy(w, "true", 4); w += 4;
+  } else if (tvisfalse(o)) {
+    w = json_more(w, sbx, 5);
+    memcpy(w, "false", 5); w += 5;
+  } else {
+    lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADENC, lj_typename(o));
+  }
+  return w;
+}
+
+/* -- Decoder ------------------------------------------------------------- */
+
+typedef struct JSONState {
+  SBufExt *sbx;		/* Buffer to decode from. */
+  const char *b;	/* Start of input, for error positions. */
+  const char *e;	/* End of input. */
+  GCstr *kcache[JSON_KCACHE];  /* Recently used object keys. */
+} JSONState;
+
+static LJ_NOINLINE void json_err(JSONState *js, const char *p)
+{
+  lj_err_callerv(sbufL(js->sbx), LJ_ERR_BUFFER_BADJSON, (int32_t)(p - js->b));
+}
+
+/* Scan a number. Returns the end or NULL if malformed. */
+static const char *json_scannum(lua_State *L, const char *p, const char *e,
+				TValue *o)
+{
+  const char *q = p, *d;
+  int neg = 0, simple = 1;
+  if (*q == '-') q++, neg = 1;
+  if (q >= e || !lj_char_isdigit((uint8_t)*q)) return NULL;
+  d = q;
+  if (*q == '0') q++; else while (q < e && lj_char_isdigit((uint8_t)*q)) q++;
+  if (q < e && *q == '.') {
+    q++;
+    if (q >= e || !lj_char_isdigit((uint8_t)*q)) return NULL;
+    while (q < e && lj_char_isdigit((uint8_t)*q)) q++;
+    simple = 0;
+  }
+  if (q < e && (*q | 0x20) == 'e') {
+    q++;
+    if (q < e && (*q == '+' || *q == '-')) q++;
+    if (q >= e || !lj_char_isdigit((uint8_t)*q)) return NULL;
+    while (q < e && lj_char_isdigit((uint8_t)*q)) q++;
+    simple = 0;
+  }
+  if (simple && q - d <= 9 && !(neg && *d == '0')) {  /* Fast path. */
+    int32_t k = 0;
+    for (; d < q; d++) k = k*10 + (*d - '0');
+    setintV(o, neg ? -k : k);
+  } else {  /* The scanner needs a NUL-terminated copy. */
+    MSize len = (MSize)(q - p);
+    char *s = lj_buf_tmp(L, len+1);
+    memcpy(s, p, len); s[len] = '\0';
+    if (lj_strscan_scan((const uint8_t *)s, len, o,
+		LJ_DUALNUM ? STRSCAN_OPT_TOINT : STRSCAN_OPT_TONUM) ==
+	STRSCAN_ERROR)
+      return NULL;
+  }
+  return q;
+}
+
+/* Parse 4 hex digits. Returns -1 if malformed. */
+static int32_t json_hex4(const char *p, const char *e)
+{
+  int32_t c = 0, i;
+  if (e - p < 4) return -1;
+  for (i = 0; i < 4; i++) {
+    uint32_t d = (uint8_t)p[i];
+    if (!lj_char_isxdigit(d)) return -1;
+    c = (c << 4) + (int32_t)(lj_char_isdigit(d) ? d - '0' : (d | 0x20) - 'a' + 10);
+  }
+  return c;
+}
+
+/* Get an object key, using the key cache. */
+static GCstr *json_key(JSONState *js, const char *p, MSize len)
+{
+  GCstr **sp, *s;
+  if (len == 0) return &G(sbufL(js->sbx))->strempty;
+  sp = &js->kcache[(len ^ ((uint8_t)p[0] << 2) ^ ((uint8_t)p[len-1] << 4)) &
+		   (JSON_KCACHE-1)];
+  s = *sp;
+  if (!(s && s->len == len && memcmp(strdata(s), p, len) == 0))
+    *sp = s = lj_str_new(sbufL(js->sbx), p, len);
+  return s;
+}
+
+/* Get a string. p points after the opening quote. */
+static const char *json_getstr(JSONState *js, const char *p, GCstr **sp,
+			       int iskey)
+{
+  lua_State *L = sbufL(js->sbx);
+  const char *q = p, *e = js->e;
+  SBuf *sb;
+  while (e - q >= 8 && !json_quote(json_ru64(q))) q += 8;
+  while (q < e && *q != '"' && *q != '\\') q++;
+  if (q >= e) json_err(js, p-1);
+  if (LJ_LIKELY(*q == '"')) {  /* Fast path without escapes. */
+    *sp = iskey ? json_key(js, p, (MSize)(q - p)) :
+		  lj_str_new(L, p, (size_t)(q - p));
+    return q+1;
+  }
+  sb = lj_buf_tmp_(L);
+  for (;;) {
+    int32_t c;
+    char *w;
+    lj_buf_putmem(sb, p, (MSize)(q - p));
+    if (q >= e) json_err(js, q);
+    if (*q == '"') break;
+    if (++q >= e) json_err(js, q);
+    switch (*q++) {
+    case '"': c = '"'; break;
+    case '\\': c = '\\'; break;
+    case '/': c = '/'; break;
+    case 'b': c = '\b'; break;
+    case 'f': c = '\f'; break;
+    case 'n': c = '\n'; break;
+    case 'r': c = '\r'; break;
+    case 't': c = '\t'; break;
+    case 'u':
+      c = json_hex4(q, e);
+      if (c < 0) json_err(js, q);
+      q += 4;
+      if (c >= 0xd800 && c < 0xdc00 && e - q >= 6 && q[0] == '\\' &&
+	  q[1] == 'u') {  /* Combine a surrogate pair. */
+	int32_t c2 = json_hex4(q+2, e);
+	if (c2 >= 0xdc00 && c2 < 0xe000) {
+	  c = 0x10000 + ((c - 0xd800) << 10) + (c2 - 0xdc00);
+	  q += 6;
+	}
+      }
+      w = lj_buf_more(sb, 4);
+      if (c < 0x80) {
+	*w++ = (char)c;
+      } else if (c < 0x800) {
+	*w++ = (char)(0xc0 | (c >> 6));
+	*w++ = (char)(0x80 | (c & 0x3f));
+      } else if (c < 0x10000) {
+	*w++ = (char)(0xe0 | (c >> 12));
+	*w++ = (char)(0x80 | ((c >> 6) & 0x3f));
+	*w++ = (char)(0x80 | (c & 0x3f));
+      } else {
+	*w++ = (char)(0xf0 | (c >> 18));
+	*w++ = (char)(0x80 | ((c >> 12) & 0x3f));
+	*w++ = (char)(0x80 | ((c >> 6) & 0x3f));
+	*w++ = (char)(0x80 | (c & 0x3f));
+      }
+      sb->w = w;
+      goto next;
+    default:
+      json_err(js, q-2);
+      c = 0;
+      break;
+    }
+    lj_buf_putb(sb, c);
+  next:
+    for (p = q; q < e && *q != '"' && *q != '\\'; q++) ;
+  }
+  *sp = lj_str_new(L, sb->b, sbuflen(sb));
+  return q+1;
+}
+
+static const char *json_get(JSONState *js, const char *p, TValue *o)
+{
+  SBufExt *sbx = js->sbx;
+  lua_State *L = sbufL(sbx);
+  const char *e = js->e;
+  p = json_skipws(p, e);
+  if (p >= e) json_err(js, p);
+  switch (*p) {
+  case '{': {
+    GCtab *t = lj_tab_new(L, 0, 0);
+    settabV(L, o, t);
+    if (sbx->depth <= 0) lj_err_caller(L, LJ_ERR_BUFFER_DEPTH);
+    sbx->depth--;
+    p = json_skipws(p+1, e);
+    if (p < e && *p == '}') {
+      p++;
+    } else {
+      for (;;) {
+	GCstr *k;
+	TValue v;
+	if (p >= e || *p != '"') json_err(js, p);
+	p = json_skipws(json_getstr(js, p+1, &k, 1), e);
+	if (p >= e || *p != ':') json_err(js, p);
+	p = json_skipws(json_get(js, p+1, &v), e);
+	copyTV(L, lj_tab_setstr(L, t, k), &v);
+	if (p < e && *p == ',') {
+	  p = json_skipws(p+1, e);
+	} else if (p < e && *p == '}') {
+	  p++;
+	  break;
+	} else {
+	  json_err(js, p);
+	}
+      }
+    }
+    sbx->depth++;
+    return p;
+    }
+  case '[': {
+    GCtab *t = lj_tab_new(L, 0, 0);
+    uint32_t i = 1;
+    settabV(L, o, t);
+    if (sbx->depth <= 0) lj_err_caller(L, LJ_ERR_BUFFER_DEPTH);
+    sbx->depth--;
+    p = json_skipws(p+1, e);
+    if (p < e && *p == ']') {
+      p++;
+    } else {
+      for (;; i++) {
+	TValue v;
+	p = json_skipws(json_get(js, p, &v), e);
+	if (i >= t->asize) lj_tab_reasize(L, t, i < 8 ? 8 : 2*i);
+	copyTV(L, arrayslot(t, i), &v);
+	if (p < e && *p == ',') {
+	  p++;
+	} else if (p < e && *p == ']') {
+	  p++;
+	  break;
+	} else {
+	  json_err(js, p);
+	}
+      }
+    }
+    sbx->depth++;
+    return p;
+    }
+  case '"': {
+    GCstr *s;
+    p = json_getstr(js, p+1, &s, 0);
+    setstrV(L, o, s);
+    return p;
+    }
+  case 't':
+    if (e - p >= 4 && !memcmp(p, "true", 4)) {
+      setboolV(o, 1);
+      return p+4;
+    }
+    break;
+  case 'f':
+    if (e - p >= 5 && !memcmp(p, "false", 5)) {
+      setboolV(o, 0);
+      return p+5;
+    }
+    break;
+  case 'n':
+    if (e - p >= 4 && !memcmp(p, "null", 4)) {
+#if LJ_64
+      setrawlightudV(o, lj_lightud_intern(L, NULL));
+#else
+      setrawlightudV(o, NULL);
+#endif
+      return p+4;
+    }
+    break;
+  default: {
+    const char *q = json_scannum(L, p, e, o);
+    if (q) return q;
+    break;
+    }
+  }
+  json_err(js, p);
+  return p;
+}
+
+/* -- External JSON API --------------------------------------------------- */
+
+/* Encode to buffer. */
+SBufExt * LJ_FASTCALL lj_json_put(SBufExt *sbx, cTValue *o)
+{
+  sbx->depth = LJ_SERIALIZE_DEPTH;
+  sbx->w = json_put(sbx->w, sbx, o);
+  return sbx;
+}
+
+/* Decode from buffer. Also consumes trailing whitespace. */
+char * LJ_FASTCALL lj_json_get(SBufExt *sbx, TValue *o)
+{
+  JSONState js;
+  const char *p;
+  js.sbx = sbx;
+  js.b = sbx->r;
+  js.e = sbx->w;
+  memset(js.kcache, 0, sizeof(js.kcache));
+  sbx->depth = LJ_SERIALIZE_DEPTH;
+  p = json_get(&js, sbx->r, o);
+  return (char *)json_skipws(p, js.e);
+}
+
+#if LJ_HASJIT
+/* Peek into buffer to find the result IRType for specialization purposes. */
+LJ_FUNC MSize LJ_FASTCALL lj_json_peektype(SBufExt *sbx)
+{
+  const char *p = json_skipws(sbx->r, sbx->w);
+  if (p < sbx->w) {
+    /* This must match the handling of all values in the decoder above. */
+    switch (*p) {
+    case '{': case '[': return IRT_TAB;
+    case '"': return IRT_STR;
+    case 't': return IRT_TRUE;
+    case 'f': return IRT_FALSE;
+    case 'n': return IRT_LIGHTUD;
+    default:
+#if LJ_DUALNUM
+      {
+	TValue tv;
+	if (json_scannum(sbufL(sbx), p, sbx->w, &tv) && tvisint(&tv))
+	  return IRT_INT;
+      }
+#endif
+      return IRT_NUM;
+    }
+  }
+  return IRT_NIL;  /* Will fail on actual decode. */
+}
+#endif
+
+#endif
@@ -0,0 +1,22 @@
+/*
+** JSON encoding and decoding.
+** Copyright (C) 2005-2022 Mike Pall. See Copyright Notice in luajit.h
+*/
+
+#ifndef _LJ_JSON_H
+#define _LJ_JSON_H
+
+#include "lj_obj.h"
+#include "lj_buf.h"
+
+#if LJ_HASBUFFER
+
+LJ_FUNC SBufExt * LJ_FASTCALL lj_json_put(SBufExt *sbx, cTValue *o);
+LJ_FUNC char * LJ_FASTCALL lj_json_get(SBufExt *sbx, TValue *o);
+#if LJ_HASJIT
+LJ_FUNC MSize LJ_FASTCALL lj_json_peektype(SBufExt *sbx);
+#endif
+
+#endif
+
+#endif
@@ -79,6 +79,97 @@ static LJ_AINLINE LexChar lex_savenext(LexState *ls)
   return lex_next(ls);
 }
 
+/* -- Bulk scanning ------------------------------------------------------- */
+
+/*
+** The fast paths below scan the current input chunk [ls->p, ls->pe) a
+** machine word at a time (SWAR) and consume whole runs of bytes at once.
+** The current char is always ls->p[-1] when it was read from the chunk.
+** They stop at the chunk end and let lex_next() fetch more input. Not used
+** with an end marker, since the word loads may read ahead of the token.
+*/
+
+typedef uintptr_t LexWord;
+
+#define LEX_WSZ		((ptrdiff_t)sizeof(LexWord))
+#define LEX_ONES	(~(LexWord)0 / 255)
+#define LEX_HIGHS	(LEX_ONES << 7)
+#define lex_bytes(c)	(LEX_ONES * (LexWord)(c))
+
+/* Non-zero if any byte of the word is zero. */
+#define lex_haszero(x)	(((x) - LEX_ONES) & ~(x) & LEX_HIGHS)
+
+static LJ_AINLINE LexWord lex_getword(const char *p)
+{
+  LexWord x;
+  memcpy(&x, p, sizeof(LexWord));
+  return x;
+}
+
+/* Find first of the bytes a, b, c, d in [p, pe). Returns pe if none. */
+static LJ_AINLINE const char *lex_find(const char *p, const char *pe,
+				       int a, int b, int c, int d)
+{
+  while (pe - p >= LEX_WSZ) {
+    LexWord x = lex_getword(p);
+    if (lex_haszero(x ^ lex_bytes(a)) | lex_haszero(x ^ lex_bytes(b)) |
+	lex_haszero(x ^ lex_bytes(c)) | lex_haszero(x ^ lex_bytes(d)))
+      break;
+    p += LEX_WSZ;
+  }
+  for (; p < pe; p++) {
+    int ch = (uint8_t)*p;
+    if (ch == a || ch == b || ch == c || ch == d) break;
+  }
+  return p;
+}
+
+/* Find first non-identifier char in [p, pe). Returns pe if none. */
+static const char *lex_findnonident(const char *p, const char *pe)
+{
+  while (pe - p >= LEX_WSZ) {
+    LexWord x = lex_getword(p), a = x & ~LEX_HIGHS, l = a | lex_bytes(0x20);
+    /* Per-byte range checks on 7 bit values can't carry into the next byte. */
+    LexWord alpha = (l + lex_bytes(0x80-'a')) & ~(l + lex_bytes(0x7f-'z'));
+    LexWord digit = (a + lex_bytes(0x80-'0')) & ~(a + lex_bytes(0x7f-'9'));
+    LexWord under = ~((a ^ lex_bytes('_')) + lex_bytes(0x7f));
+    if (((x | alpha | digit | under) & LEX_HIGHS) != LEX_HIGHS) break;
+    p += LEX_WSZ;
+  }
+  while (p < pe && lj_char_isident((uint8_t)*p)) p++;
+  return p;
+}
+
+/* Find first char in [p, pe) that isn't a blank. Returns pe if none. */
+static const char *lex_findnonblank(const char *p, const char *pe)
+{
+  while (pe - p >= LEX_WSZ) {
+    LexWord x = lex_getword(p);
+    if (x != lex_bytes(' ') && x != lex_bytes('\t')) break;
+    p += LEX_WSZ;
+  }
+  while (p < pe && (*p == ' ' || *p == '\t' || *p == '\v' || *p == '\f')) p++;
+  return p;
+}
+
+/* Save current char and all chars before q. Then get char at q. */
+static LJ_AINLINE LexChar lex_saverun(LexState *ls, const char *q)
+{
+  MSize len = (MSize)(q - ls->p + 1);
+  char *w = lj_buf_more(&ls->sb, len);
+  memcpy(w, ls->p - 1, len);
+  ls->sb.w = w + len;
+  ls->p = q;
+  return lex_next(ls);
+}
+
+/* Skip current char and all chars before q. Then get char at q. */
+static LJ_AINLINE LexChar lex_skiprun(LexState *ls, const char *q)
+{
+  ls->p = q;
+  return lex_next(ls);
+}
+
 /* Skip line break. Handles "\n", "\r", "\r\n" or "\n\r". */
 static void lex_newline(LexState *ls)
 {
@@ -172,7 +263,12 @@ static void lex_longstring(LexState *ls, TValue *tv, int sep)
       if (!tv) lj_buf_reset(&ls->sb);  /* Don't waste space for comments. */
       break;
     default:
-      lex_savenext(ls);
+      if (LJ_LIKELY(!ls->endmark)) {
+	const char *q = lex_find(ls->p, ls->pe, ']', '\n', '\r', ']');
+	if (tv) lex_saverun(ls, q); else lex_skiprun(ls, q);
+      } else {
+	lex_savenext(ls);
+      }
       break;
     }
   } endloop:
@@ -277,7 +373,10 @@ static void lex_string(LexState *ls, TValue *tv)
       continue;
       }
     default:
-      lex_savenext(ls);
+      if (LJ_LIKELY(!ls->endmark))
+	lex_saverun(ls, lex_find(ls->p, ls->pe, delim, '\\', '\n', '\r'));
+      else
+	lex_savenext(ls);
       break;
     }
   }
@@ -301,7 +400,10 @@ static LexToken lex_scan(LexState *ls, TValue *tv)
       }
       /* Identifier or reserved word. */
       do {
-	lex_savenext(ls);
+	if (LJ_LIKELY(!ls->endmark))
+	  lex_saverun(ls, lex_findnonident(ls->p, ls->pe));
+	else
+	  lex_savenext(ls);
       } while (lj_char_isident(ls->c));
       s = lj_parse_keepstr(ls, ls->sb.b, sbuflen(&ls->sb));
       setstrV(ls->L, tv, s);
@@ -318,7 +420,10 @@ static LexToken lex_scan(LexState *ls, TValue *tv)
     case '\t':
     case '\v':
     case '\f':
-      lex_next(ls);
+      if (LJ_LIKELY(!ls->endmark))
+	lex_skiprun(ls, lex_findnonblank(ls->p, ls->pe));
+      else
+	lex_next(ls);
       continue;
     case '-':
       lex_next(ls);
@@ -334,8 +439,12 @@ static LexToken lex_scan(LexState *ls, TValue *tv)
 	}
       }
       /* Short comment "--.*\n". */
-      while (!lex_iseol(ls) && ls->c != LEX_EOF)
-	lex_next(ls);
+      while (!lex_iseol(ls) && ls->c != LEX_EOF) {
+	if (LJ_LIKELY(!ls->endmark))
+	  lex_skiprun(ls, lex_find(ls->p, ls->pe, '\n', '\r', '\n', '\r'));
+	else
+	  lex_next(ls);
+      }
       continue;
     case '[': {
       int sep = lex_skipeq(ls);
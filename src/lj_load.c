@@ -23,6 +23,11 @@
 #include "lj_lex.h"
 #include "lj_bcdump.h"
 #include "lj_parse.h"
+#if LJ_TARGET_POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lj_io.h"
+#endif
 
 /* -- Load Lua source code and bytecode ----------------------------------- */
 
@@ -46,22 +51,29 @@ static TValue *cpparser(lua_State *L, lua_CFunction dummy, void *ud)
   return NULL;
 }
 
-LUA_API int lua_loadx(lua_State *L, lua_Reader reader, void *data,
-		      const char *chunkname, const char *mode)
+static int load_ls(lua_State *L, LexState *ls, lua_Reader reader, void *data,
+		   const char *chunkname, const char *mode)
 {
-  LexState ls;
   int status;
-  ls.rfunc = reader;
-  ls.rdata = data;
-  ls.chunkarg = chunkname ? chunkname : "?";
-  ls.mode = mode;
-  lj_buf_init(L, &ls.sb);
-  status = lj_vm_cpcall(L, NULL, &ls, cpparser);
-  lj_lex_cleanup(L, &ls);
+  ls->rfunc = reader;
+  ls->rdata = data;
+  ls->chunkarg = chunkname ? chunkname : "?";
+  ls->mode = mode;
+  lj_buf_init(L, &ls->sb);
+  status = lj_vm_cpcall(L, NULL, ls, cpparser);
+  lj_lex_cleanup(L, ls);
   lj_gc_check(L);
   return status;
 }
 
+LUA_API int lua_loadx(lua_State *L, lua_Reader reader, void *data,
+		      const char *chunkname, const char *mode)
+{
+  LexState ls;
+  ls.owner = NULL;
+  return load_ls(L, &ls, reader, data, chunkname, mode);
+}
+
 LUA_API int lua_load(lua_State *L, lua_Reader reader, void *data,
 		     const char *chunkname)
 {
@@ -82,11 +94,61 @@ static const char *reader_file(lua_State *L, void *ud, size_t *size)
   return *size > 0 ? ctx->buf : NULL;
 }
 
+#if LJ_TARGET_POSIX
+/* Unmap a bytecode dump after all of its lazy prototypes are gone. */
+static int bcmap_gc(lua_State *L)
+{
+  lj_io_unmap((IOFileUD *)lua_touserdata(L, 1));
+  return 0;
+}
+
+/* Map and load a bytecode dump with lazy prototypes. -1 if not applicable. */
+static int load_mapped(lua_State *L, FILE *fp, const char *chunkname,
+		       const char *mode)
+{
+  IOFileUD *iof;
+  struct stat st;
+  char head[5];
+  int status;
+  if (fstat(fileno(fp), &st) != 0 || !S_ISREG(st.st_mode))
+    return -1;  /* Can't rewind a pipe. */
+  if (fread(head, 1, 5, fp) != 5 || head[0] != BCDUMP_HEAD1 ||
+      head[1] != BCDUMP_HEAD2 || head[2] != BCDUMP_HEAD3 ||
+      (head[4] & (0x80|BCDUMP_F_LAZY)) != BCDUMP_F_LAZY) {
+    rewind(fp);
+    return -1;
+  }
+  iof = (IOFileUD *)lua_newuserdata(L, sizeof(IOFileUD));
+  iof->fp = fp;
+  iof->type = IOFILE_TYPE_FILE;
+  iof->map = NULL;
+  if (!lj_io_map(iof)) {
+    L->top--;
+    rewind(fp);
+    return -1;
+  }
+  iof->fp = NULL;  /* The mapping outlives the file handle. */
+#ifdef MADV_NORMAL
+  madvise(iof->map, iof->mapsz, MADV_NORMAL);  /* Accessed out of order. */
+#endif
+  if (luaL_newmetatable(L, "LJ_BCMAP")) {
+    lua_pushcfunction(L, bcmap_gc);
+    lua_setfield(L, -2, "__gc");
+  }
+  lua_setmetatable(L, -2);
+  status = lj_load_owned(L, obj2gco(udataV(L->top-1)), iof->map, iof->mapsz,
+			 chunkname, mode);
+  copyTV(L, L->top-2, L->top-1);  /* Replace the owner with the result. */
+  L->top--;
+  return status;
+}
+#endif
+
 LUALIB_API int luaL_loadfilex(lua_State *L, const char *filename,
 			      const char *mode)
 {
   FileReaderCtx ctx;
-  int status;
+  int status = -1;
   const char *chunkname;
   if (filename) {
     ctx.fp = fopen(filename, "rb");
@@ -95,11 +157,15 @@ LUALIB_API int luaL_loadfilex(lua_State *L, const char *filename,
       return LUA_ERRFILE;
     }
     chunkname = lua_pushfstring(L, "@%s", filename);
+#if LJ_TARGET_POSIX
+    status = load_mapped(L, ctx.fp, chunkname, mode);
+#endif
   } else {
     ctx.fp = stdin;
     chunkname = "=stdin";
   }
-  status = lua_loadx(L, reader_file, &ctx, chunkname, mode);
+  if (status < 0)
+    status = lua_loadx(L, reader_file, &ctx, chunkname, mode);
   if (ferror(ctx.fp)) {
     L->top -= filename ? 2 : 1;
     lua_pushfstring(L, "cannot read %s: %s", chunkname+1, strerror(errno));
@@ -144,6 +210,18 @@ LUALIB_API int luaL_loadbufferx(lua_State *L, const char *buf, size_t size,
   return lua_loadx(L, reader_string, &ctx, name, mode);
 }
 
+/* Load from a buffer that stays valid as long as its owner is alive. */
+int lj_load_owned(lua_State *L, GCobj *owner, const char *buf, size_t size,
+		  const char *name, const char *mode)
+{
+  StringReaderCtx ctx;
+  LexState ls;
+  ctx.str = buf;
+  ctx.size = size;
+  ls.owner = owner;
+  return load_ls(L, &ls, reader_string, &ctx, name, mode);
+}
+
 LUALIB_API int luaL_loadbuffer(lua_State *L, const char *buf, size_t size,
 			       const char *name)
 {
@@ -167,7 +167,10 @@ TValue *lj_meta_tset(lua_State *L, cTValue *o, cTValue *k)
     cTValue *mo;
     if (LJ_LIKELY(tvistab(o))) {
       GCtab *t = tabV(o);
-      cTValue *tv = lj_tab_get(L, t, k);
+      cTValue *tv;
+      if (LJ_UNLIKELY(isfrozen(obj2gco(t))))
+	lj_err_msg(L, LJ_ERR_FROZEN);
+      tv = lj_tab_get(L, t, k);
       if (LJ_LIKELY(!tvisnil(tv))) {
 	t->nomm = 0;  /* Invalidate negative metamethod cache. */
 	lj_gc_anybarriert(L, t);
@@ -163,6 +163,19 @@ typedef struct SBuf {
   SBufHeader;
 } SBuf;
 
+/* Pool of buffer storage. One free list per power-of-two size class. */
+#define SBUFPOOL_NCLASS	12	/* LJ_MIN_SBUF .. LJ_MAX_POOLSBUF. */
+
+typedef struct SBufPool {
+  MRef list[SBUFPOOL_NCLASS];	/* Free lists, linked via the first word. */
+  uint32_t num[SBUFPOOL_NCLASS];	/* Number of free blocks. */
+  uint32_t low[SBUFPOOL_NCLASS];	/* Min. number since the last trim. */
+  GCSize retained;	/* Total size of free blocks. */
+  GCSize limit;		/* Max. total size of free blocks. */
+  uint64_t hits;	/* Storage taken from the pool. */
+  uint64_t misses;	/* Poolable storage that had to be allocated. */
+} SBufPool;
+
 /* -- Tags and values ----------------------------------------------------- */
 
 /* Frame link. */
@@ -337,6 +350,7 @@ enum {
   UDTYPE_IO_FILE,	/* I/O library FILE. */
   UDTYPE_FFI_CLIB,	/* FFI C library namespace. */
   UDTYPE_BUFFER,	/* String buffer. */
+  UDTYPE_CHANNEL,	/* Inter-state channel. */
   UDTYPE__MAX
 };
 
@@ -419,6 +433,7 @@ typedef struct GCproto {
 #define proto_knumtv(pt, idx) \
   check_exp((uintptr_t)(idx) < (pt)->sizekn, &mref((pt)->k, TValue)[(idx)])
 #define proto_bc(pt)		((BCIns *)((char *)(pt) + sizeof(GCproto)))
+#define proto_islazy(pt)	((pt)->sizebc == 0)  /* See lj_bcread_lazy(). */
 #define proto_bcpos(pt, pc)	((BCPos)((pc) - proto_bc(pt)))
 #define proto_uv(pt)		(mref((pt)->uv, uint16_t))
 
@@ -499,7 +514,10 @@ LJ_STATIC_ASSERT(offsetof(Node, val) == 0);
 typedef struct GCtab {
   GCHeader;
   uint8_t nomm;		/* Negative cache for fast metamethods. */
-  int8_t colo;		/* Array colocation. */
+  int8_t colo;		/* Array/hash colocation. */
+#if LJ_GC64
+  MSize lenhint;	/* Last computed length. Verified by lj_tab_len(). */
+#endif
   MRef array;		/* Array part. */
   GCRef gclist;
   GCRef metatable;	/* Must be at same offset in GCudata. */
@@ -508,10 +526,28 @@ typedef struct GCtab {
   uint32_t hmask;	/* Hash part mask (size of hash part - 1). */
 #if LJ_GC64
   MRef freetop;		/* Top of free elements. */
+#else
+  MSize lenhint;	/* Last computed length. Verified by lj_tab_len(). */
+  uint32_t unused1;
 #endif
 } GCtab;
 
+/* Layout of t->colo: bits 0-4 hold the size of a colocated array part,
+** bits 5-6 the hbits of a colocated hash part. Bit 7 is set once the
+** colocated array part has been separated (colo < 0).
+*/
+#define LJ_COLO_AMASK	0x1f
+#define LJ_COLO_HSHIFT	5
+#define LJ_COLO_ASEP	0x80
+
+#define colo_asize(t)	((uint32_t)(uint8_t)(t)->colo & LJ_COLO_AMASK)
+#define colo_hbits(t)	(((uint32_t)(uint8_t)(t)->colo >> LJ_COLO_HSHIFT) & 3)
+#define colo_node(t)	((Node *)((char *)(t) + sizetabcolo(colo_asize(t))))
+
 #define sizetabcolo(n)	((n)*sizeof(TValue) + sizeof(GCtab))
+#define sizetabcoloh(hbits)	((hbits) ? sizeof(Node) << (hbits) : 0)
+
+LJ_STATIC_ASSERT(LJ_MAX_COLOSIZE <= LJ_COLO_AMASK && LJ_MAX_COLOHBITS <= 3);
 #define tabref(r)	((GCtab *)gcref((r)))
 #define noderef(r)	(mref((r), Node))
 #define nextnode(n)	(mref((n)->next, Node))
@@ -606,6 +642,7 @@ typedef struct GCState {
   GCRef grayagain;	/* List of objects for atomic traversal. */
   GCRef weak;		/* List of weak tables (to be cleared). */
   GCRef mmudata;	/* List of userdata (to be finalized). */
+  GCRef frozen;		/* List of frozen objects. */
   GCSize debt;		/* Debt (how much GC is behind schedule). */
   GCSize estimate;	/* Estimate of memory actually in use. */
   MSize stepmul;	/* Incremental GC step granularity. */
@@ -642,6 +679,7 @@ typedef struct global_State {
   volatile int32_t vmstate;  /* VM state or current JIT code trace number. */
   GCRef mainthref;	/* Link to main thread. */
   SBuf tmpbuf;		/* Temporary string buffer. */
+  SBufPool bufpool;	/* Pool of storage for buffer objects. */
   TValue tmptv, tmptv2;	/* Temporary TValues. */
   Node nilnode;		/* Fallback 1-element hash part (nil key and value). */
   TValue registrytv;	/* Anchor for registry. */
@@ -947,9 +947,11 @@ LJFOLDF(kfold_strto)
 
 /* -- Constant folding of equality checks --------------------------------- */
 
-/* Don't constant-fold away FLOAD checks against KNULL. */
+/* Don't constant-fold away FLOAD or CALLA checks against KNULL. */
 LJFOLD(EQ FLOAD KNULL)
 LJFOLD(NE FLOAD KNULL)
+LJFOLD(EQ CALLA KNULL)
+LJFOLD(NE CALLA KNULL)
 LJFOLDX(lj_opt_cse)
 
 /* But fold all other KNULL compares, since only KNULL is equal to KNULL. */
@@ -2332,6 +2334,7 @@ LJFOLDF(fload_cdata_ptr_int64_cnew)
 LJFOLD(FLOAD any IRFL_STR_LEN)
 LJFOLD(FLOAD any IRFL_FUNC_ENV)
 LJFOLD(FLOAD any IRFL_THREAD_ENV)
+LJFOLD(FLOAD any IRFL_TAB_MARKED)  /* Only used for the frozen flag. */
 LJFOLD(FLOAD any IRFL_CDATA_CTYPEID)
 LJFOLD(FLOAD any IRFL_CDATA_PTR)
 LJFOLD(FLOAD any IRFL_CDATA_INT)
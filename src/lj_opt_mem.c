@@ -73,14 +73,15 @@ static AliasRet aa_table(jit_State *J, IRRef ta, IRRef tb)
   return aa_escape(J, taba, tabb);
 }
 
-/* Check whether there's no aliasing table.clear. */
+/* Check whether there's no aliasing table.clear or table.move. */
 static int fwd_aa_tab_clear(jit_State *J, IRRef lim, IRRef ta)
 {
   IRRef ref = J->chain[IR_CALLS];
   while (ref > lim) {
     IRIns *calls = IR(ref);
-    if (calls->op2 == IRCALL_lj_tab_clear &&
-	(ta == calls->op1 || aa_table(J, ta, calls->op1) != ALIAS_NO))
+    IRRef tb = calls->op2 == IRCALL_lj_tab_clear ? calls->op1 :
+	       calls->op2 == IRCALL_lj_tab_move ? IR(calls->op1)->op2 : 0;
+    if (tb && (ta == tb || aa_table(J, ta, tb) != ALIAS_NO))
       return 0;  /* Conflict. */
     ref = calls->prev;
   }
@@ -331,6 +332,10 @@ int LJ_FASTCALL lj_opt_fwd_href_nokey(jit_State *J)
     }
   }
 
+  /* A table.move may add keys to the hash part, too. */
+  if (!fwd_aa_tab_clear(J, lim, fins->op1))
+    return 0;  /* Conflict. */
+
   /* Search for conflicting stores. */
   ref = J->chain[IR_HSTORE];
   while (ref > lim) {
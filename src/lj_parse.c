@@ -132,6 +132,7 @@ typedef struct FuncState {
   BCReg freereg;		/* First free register. */
   BCReg nactvar;		/* Number of active local variables. */
   BCReg nkn, nkgc;		/* Number of lua_Number/GCobj constants */
+  GCtab *ktpl;			/* Template of last constant table constructor. */
   BCLine linedefined;		/* First line of the function definition. */
   BCInsLine *bcbase;		/* Base of bytecode stack. */
   BCPos bclim;			/* Limit of bytecode stack. */
@@ -1625,6 +1626,7 @@ static void fs_init(LexState *ls, FuncState *fs)
   fs->jpc = NO_JMP;
   fs->freereg = 0;
   fs->nkgc = 0;
+  fs->ktpl = NULL;
   fs->nkn = 0;
   fs->nactvar = 0;
   fs->nuv = 0;
@@ -1715,6 +1717,38 @@ static void expr_kvalue(FuncState *fs, TValue *v, ExpDesc *e)
   }
 }
 
+/* Check for a constant table constructor which can be nested in a template. */
+static int expr_isktab(FuncState *fs, ExpDesc *e)
+{
+  if (e->k == VRELOCABLE && e->u.s.info == fs->pc-1) {
+    BCIns ins = fs->bcbase[e->u.s.info].ins;
+    if (bc_op(ins) == BC_TNEW) {
+      return 1;  /* Empty constructor. */
+    } else if (bc_op(ins) == BC_TDUP && bc_d(ins) == fs->nkgc-1 && fs->ktpl) {
+      TValue key;
+      cTValue *o;
+      settabV(fs->L, &key, fs->ktpl);
+      o = lj_tab_get(fs->L, fs->kt, &key);
+      return tvhaskslot(o) && tvkslot(o) == bc_d(ins);
+    }
+  }
+  return 0;
+}
+
+/* Drop constant table constructor and get its value for the outer template. */
+static void expr_ktab(FuncState *fs, TValue *v)
+{
+  BCIns ins = fs->bcbase[--fs->pc].ins;
+  if (bc_op(ins) == BC_TDUP) {  /* Remove the template from the constants. */
+    GCtab *t = fs->ktpl;
+    settabV(fs->L, v, t);
+    setnilV(lj_tab_set(fs->L, fs->kt, v));
+    fs->nkgc--;
+  } else {
+    settabV(fs->L, v, lj_tab_new(fs->L, 0, 0));
+  }
+}
+
 /* Parse table constructor expression. */
 static void expr_table(LexState *ls, ExpDesc *e)
 {
@@ -1751,8 +1785,11 @@ static void expr_table(LexState *ls, ExpDesc *e)
     }
     expr(ls, &val);
     if (expr_isk(&key) && key.k != VKNIL &&
-	(key.k == VKSTR || expr_isk_nojump(&val))) {
-      TValue k, *v;
+	(key.k == VKSTR || expr_isk_nojump(&val) || expr_isktab(fs, &val))) {
+      TValue k, kv, *v;
+      int isktab = !expr_isk_nojump(&val) && expr_isktab(fs, &val);
+      if (isktab)  /* Must be dropped before the template is added. */
+	expr_ktab(fs, &kv);
       if (!t) {  /* Create template table on demand. */
 	BCReg kidx;
 	t = lj_tab_new(fs->L, needarr ? narr : 0, hsize2hbits(nhash));
@@ -1765,6 +1802,8 @@ static void expr_table(LexState *ls, ExpDesc *e)
       lj_gc_anybarriert(fs->L, t);
       if (expr_isk_nojump(&val)) {  /* Add const key/value to template table. */
 	expr_kvalue(fs, v, &val);
+      } else if (isktab) {  /* Nest constant table into template table. */
+	copyTV(fs->L, v, &kv);
       } else {  /* Otherwise create dummy string key (avoids lj_tab_newkey). */
 	settabV(fs->L, v, t);  /* Preserve key with table itself as value. */
 	fixt = 1;   /* Fix this later, after all resizes. */
@@ -1794,6 +1833,7 @@ static void expr_table(LexState *ls, ExpDesc *e)
     setbc_b(&ilp[-1].ins, 0);
   }
   if (pc == fs->pc-1) {  /* Make expr relocable if possible. */
+    fs->ktpl = t;  /* Constant constructor, may be nested in a template. */
     e->u.s.info = pc;
     fs->freereg--;
     e->k = VRELOCABLE;
@@ -1814,10 +1854,8 @@ static void expr_table(LexState *ls, ExpDesc *e)
       uint32_t i, hmask = t->hmask;
       for (i = 0; i <= hmask; i++) {
 	Node *n = &node[i];
-	if (tvistab(&n->val)) {
-	  lj_assertFS(tabV(&n->val) == t, "bad dummy key in template table");
+	if (tvistab(&n->val) && tabV(&n->val) == t)
 	  setnilV(&n->val);  /* Turn value into nil. */
-	}
       }
     }
     lj_gc_check(fs->L);
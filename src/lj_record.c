@@ -14,6 +14,7 @@
 #include "lj_err.h"
 #include "lj_str.h"
 #include "lj_tab.h"
+#include "lj_gc.h"
 #include "lj_meta.h"
 #include "lj_frame.h"
 #if LJ_HASFFI
@@ -789,7 +790,7 @@ static TRef rec_call_specialize(jit_State *J, GCfunc *fn, TRef tr)
     switch (fn->c.ffid) {
     case FF_coroutine_wrap_aux:
     case FF_string_gmatch_aux:
-      /* NYI: io_file_iter doesn't have an ffid, yet. */
+    case FF_io_lines_iter:
       {  /* Specialize to the ffid. */
 	TRef trid = emitir(IRT(IR_FLOAD, IRT_U8), tr, IRFL_FUNC_FFID);
 	emitir(IRTGI(IR_EQ), trid, lj_ir_kint(J, fn->c.ffid));
@@ -1342,15 +1343,15 @@ static void rec_idx_bump(jit_State *J, RecordIndex *ix)
 	node = noderef(tpl->node);
 	hmask = tpl->hmask;
 	for (i = 0; i <= hmask; i++) {
-	  /* This is safe, since template tables only hold immutable values. */
-	  if (tvistab(&node[i].val))
+	  /* Only the dummy values point back to the template itself. */
+	  if (tvistab(&node[i].val) && tabV(&node[i].val) == tpl)
 	    setnilV(&node[i].val);
 	}
 	/* The shape of the table may have changed. Clean up array part, too. */
 	asize = tpl->asize;
 	array = tvref(tpl->array);
 	for (i = 0; i < asize; i++) {
-	  if (tvistab(&array[i]))
+	  if (tvistab(&array[i]) && tabV(&array[i]) == tpl)
 	    setnilV(&array[i]);
 	}
 	J->retryrec = 1;  /* Abort the trace at the end of recording. */
@@ -1488,6 +1489,17 @@ static int nommstr(jit_State *J, TRef key)
   return 1;  /* CANNOT be a metamethod name. */
 }
 
+/* Guard against stores to a frozen table. */
+void lj_record_unfrozen(jit_State *J, TRef tr)
+{
+  IRIns *ir = IR(tref_ref(tr));
+  if (!(ir->o == IR_TNEW || ir->o == IR_TDUP)) {  /* Not a new table? */
+    TRef mref = emitir(IRT(IR_FLOAD, IRT_U8), tr, IRFL_TAB_MARKED);
+    mref = emitir(IRTI(IR_BAND), mref, lj_ir_kint(J, LJ_GC_FROZEN));
+    emitir(IRTGI(IR_EQ), mref, lj_ir_kint(J, 0));
+  }
+}
+
 /* Record indexed load/store. */
 TRef lj_record_idx(jit_State *J, RecordIndex *ix)
 {
@@ -1549,6 +1561,21 @@ TRef lj_record_idx(jit_State *J, RecordIndex *ix)
     }
   }
 
+  if (ix->val) {
+    lj_record_unfrozen(J, ix->tab);
+  } else if (tref_isk2(ix->tab, ix->key) &&
+	     isfrozen(obj2gco(tabV(&ix->tabv)))) {
+    /* Loads from frozen tables with constant keys are constant. */
+    GCtab *t = tabV(&ix->tabv);
+    cTValue *tv = lj_tab_get(J->L, t, &ix->keyv);
+    if (!tvisnil(tv)) {
+      TRef tr = lj_record_constify(J, tv);
+      if (tr) return tr;
+    } else if (!ix->idxchain || !tabref(t->metatable)) {
+      return TREF_NIL;
+    }
+  }
+
   /* Record the key lookup. */
   xref = rec_idx_key(J, ix, &rbref, &rbguard);
   xrefop = IR(tref_ref(xref))->o;
@@ -1730,6 +1757,8 @@ static int rec_upvalue_constify(jit_State *J, GCupval *uvp)
 #endif
     if (!(tvistab(o) || tvisudata(o) || tvisthread(o)))
       return 1;
+    if (tvistab(o) && isfrozen(gcV(o)))
+      return 1;  /* Frozen tables are never freed, anyway. */
   }
   return 0;
 }
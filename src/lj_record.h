@@ -37,6 +37,7 @@ LJ_FUNC void lj_record_tailcall(jit_State *J, BCReg func, ptrdiff_t nargs);
 LJ_FUNC void lj_record_ret(jit_State *J, BCReg rbase, ptrdiff_t gotresults);
 
 LJ_FUNC int lj_record_mm_lookup(jit_State *J, RecordIndex *ix, MMS mm);
+LJ_FUNC void lj_record_unfrozen(jit_State *J, TRef tr);
 LJ_FUNC TRef lj_record_idx(jit_State *J, RecordIndex *ix);
 LJ_FUNC int lj_record_next(jit_State *J, RecordIndex *ix);
 
@@ -22,6 +22,7 @@
 #if LJ_HASJIT
 #include "lj_ir.h"
 #endif
+#include "lj_vm.h"
 #include "lj_serialize.h"
 
 /* Tags for internal serialization format. */
@@ -40,11 +41,11 @@ enum {
   SER_TAG_INT64,	/* 0x10 */
   SER_TAG_UINT64,
   SER_TAG_COMPLEX,
-  SER_TAG_0x13,
-  SER_TAG_0x14,
-  SER_TAG_0x15,
-  SER_TAG_0x16,
-  SER_TAG_0x17,
+  SER_TAG_SHAPE,
+  SER_TAG_SHAPE_REF,
+  SER_TAG_REF,
+  SER_TAG_ADICT_NEW,
+  SER_TAG_ADICT_REF,
   SER_TAG_0x18,		/* 0x18 */
   SER_TAG_0x19,
   SER_TAG_0x1a,
@@ -57,6 +58,9 @@ enum {
 };
 LJ_STATIC_ASSERT((SER_TAG_TAB & 7) == 0);
 
+#define SER_SHAPE_MAXKEY	64	/* Max. number of keys of a shape. */
+#define SER_ADICT_MINLEN	2	/* Min. length of adaptive dict. keys. */
+
 /* -- Helper functions ---------------------------------------------------- */
 
 static LJ_AINLINE char *serialize_more(char *w, SBufExt *sbx, MSize sz)
@@ -164,8 +168,192 @@ void LJ_FASTCALL lj_serialize_dict_prep_mt(lua_State *L, GCtab *dict)
   }
 }
 
+/* Set up the adaptive dictionaries of a new buffer object. */
+void lj_serialize_adict_init(lua_State *L, SBufExt *sbx, uint32_t sz)
+{
+  uint32_t hbits = hsize2hbits(sz);
+  GCtab *ad = lj_tab_new(L, sz+1, hbits);
+  /* NOBARRIER: The GCudata is new (marked white). */
+  setgcref(sbx->adict, obj2gco(ad));
+  ad = lj_tab_new(L, sz+1, 0);
+  setgcref(sbx->adictd, obj2gco(ad));
+  sbx->adictsz = sz;
+  sbx->adictnext = 0;
+}
+
 /* -- Internal serializer ------------------------------------------------- */
 
+static char *serialize_put(char *w, SBufExt *sbx, cTValue *o);
+
+/* Put string key into buffer, using the adaptive dictionary.
+** A new key takes the next slot in FIFO order and evicts the old key.
+** It's sent along with its slot number, so the decoder can mirror it.
+*/
+static LJ_NOINLINE char *serialize_putkey_adict(char *w, SBufExt *sbx,
+						GCstr *str)
+{
+  lua_State *L = sbufL(sbx);
+  GCtab *ad = tabref(sbx->adict);
+  cTValue *tv = lj_tab_getstr(ad, str);
+  MSize len = str->len;
+  uint32_t idx;
+  int32_t k;
+  if (tv && !tvisnil(tv)) {
+    w = serialize_more(w, sbx, 1+5);
+    *w++ = SER_TAG_ADICT_REF;
+    return serialize_wu124(w, tv->u32.lo);
+  }
+  idx = sbx->adictnext;
+  sbx->adictnext = idx+1 < sbx->adictsz ? idx+1 : 0;
+  if (sbx->adictnew < sbx->adictsz) sbx->adictnew++;
+  k = (int32_t)idx+1;
+  lj_gc_anybarriert(L, ad);
+  tv = lj_tab_getint(ad, k);
+  if (tv && tvisstr(tv))  /* Evict old key. */
+    setnilV(lj_tab_setstr(L, ad, strV(tv)));
+  setstrV(L, lj_tab_setint(L, ad, k), str);
+  lj_tab_setstr(L, ad, str)->u64 = idx;
+  w = serialize_more(w, sbx, 1+2*5+len);
+  *w++ = SER_TAG_ADICT_NEW;
+  w = serialize_wu124(w, idx);
+  w = serialize_wu124(w, len);
+  return lj_buf_wmem(w, strdata(str), len);
+}
+
+/* Undo the new keys of an encode that was aborted by an error.
+** The decoder never sees its output. The touched slots are dropped, since
+** the keys they evicted are gone. Both sides then agree on all other slots.
+*/
+static LJ_NOINLINE void serialize_adict_undo(SBufExt *sbx)
+{
+  lua_State *L = sbufL(sbx);
+  GCtab *ad = tabref(sbx->adict);
+  uint32_t idx = sbx->adictmark, n = sbx->adictnew;
+  for (; n; n--) {
+    TValue *tv = lj_tab_setint(L, ad, (int32_t)idx+1);
+    if (tvisstr(tv)) {
+      setnilV(lj_tab_setstr(L, ad, strV(tv)));
+      setnilV(tv);
+    }
+    idx = idx+1 < sbx->adictsz ? idx+1 : 0;
+  }
+  sbx->adictnext = sbx->adictmark;
+  sbx->adictnew = 0;
+}
+
+/* Put string key into buffer, using the string dictionaries. */
+static LJ_AINLINE char *serialize_putkey(char *w, SBufExt *sbx,
+					 GCtab *dict_str, const GCstr *str)
+{
+  MSize len = str->len;
+  if (dict_str) {
+    /* Inlined lj_tab_getstr is 30% faster. */
+    Node *n = hashstr(dict_str, str);
+    do {
+      if (tvisstr(&n->key) && strV(&n->key) == str) {
+	uint32_t idx = n->val.u32.lo;
+	w = serialize_more(w, sbx, 1+5);
+	*w++ = SER_TAG_DICT_STR;
+	return serialize_wu124(w, idx);
+      }
+    } while ((n = nextnode(n)));
+  }
+  if (sbx->adictsz && len >= SER_ADICT_MINLEN)
+    return serialize_putkey_adict(w, sbx, (GCstr *)str);
+  w = serialize_more(w, sbx, 5+len);
+  w = serialize_wu124(w, SER_TAG_STR + len);
+  return lj_buf_wmem(w, strdata(str), len);
+}
+
+/* Put table with string keys by shape. Returns NULL if not possible. */
+static char *serialize_put_shape(char *w, SBufExt *sbx, const GCtab *t,
+				 uint32_t nhash)
+{
+  lua_State *L = sbufL(sbx);
+  GCstr *keys[SER_SHAPE_MAXKEY];
+  GCtab *st = tabref(sbx->shapes);
+  GCtab *dict_str = tabref(sbx->dict_str);
+  const Node *node = noderef(t->node) + t->hmask;
+  MSize i, sz = nhash*(MSize)sizeof(GCstr *);
+  uint32_t id = sbx->lastshape;
+  int def = 0;
+  cTValue *last;
+  if (nhash > SER_SHAPE_MAXKEY) return NULL;
+  for (i = 0; i < nhash; node--)  /* Same order as the values below. */
+    if (!tvisnil(&node->val)) {
+      if (!tvisstr(&node->key)) return NULL;
+      keys[i++] = strV(&node->key);
+    }
+  /* Most often the same shape as last time. Otherwise look it up. */
+  last = st ? lj_tab_getint(st, (int32_t)id+1) : NULL;
+  if (!(last && tvisstr(last) && strV(last)->len == sz &&
+	memcmp(strVdata(last), keys, sz) == 0)) {
+    GCstr *sig = lj_str_new(L, (const char *)keys, sz);
+    TValue *tv;
+    if (!st) {
+      st = lj_tab_new(L, 8, 3);
+      setgcref(sbx->shapes, obj2gco(st));
+    }
+    tv = lj_tab_setstr(L, st, sig);
+    if (tvisnil(tv)) {  /* New shape. */
+      id = sbx->nshapes++;
+      tv->u64 = id;
+      setstrV(L, lj_tab_setint(L, st, (int32_t)id+1), sig);
+      def = 1;
+    } else {
+      id = tv->u32.lo;
+    }
+    sbx->lastshape = id;
+  }
+  w = serialize_more(w, sbx, 1+5);
+  if (def) {  /* Define shape: tag, number of keys, keys. */
+    *w++ = SER_TAG_SHAPE;
+    w = serialize_wu124(w, nhash);
+    for (i = 0; i < nhash; i++) {
+      if (LJ_UNLIKELY(dict_str || sbx->adictsz)) {
+	w = serialize_putkey(w, sbx, dict_str, keys[i]);
+      } else {
+	MSize len = keys[i]->len;
+	w = serialize_more(w, sbx, 5+len);
+	w = serialize_wu124(w, SER_TAG_STR + len);
+	w = lj_buf_wmem(w, strdata(keys[i]), len);
+      }
+    }
+  } else {  /* Reference shape: tag, shape index. */
+    *w++ = SER_TAG_SHAPE_REF;
+    w = serialize_wu124(w, id);
+  }
+  for (node = noderef(t->node) + t->hmask; ; node--)  /* Write values. */
+    if (!tvisnil(&node->val)) {
+      w = serialize_put(w, sbx, &node->val);
+      if (--nhash == 0) break;
+    }
+  return w;
+}
+
+/* Write a reference to a table that has been seen before.
+** Otherwise, assign the next index to the table and return NULL.
+*/
+static char *serialize_put_ref(char *w, SBufExt *sbx, GCtab *t)
+{
+  lua_State *L = sbufL(sbx);
+  GCtab *rt = tabref(sbx->refs);
+  TValue k, *tv;
+  if (!rt) {
+    rt = lj_tab_new(L, 0, 4);
+    setgcref(sbx->refs, obj2gco(rt));
+  }
+  settabV(L, &k, t);
+  tv = lj_tab_set(L, rt, &k);
+  if (tvisnil(tv)) {
+    tv->u64 = sbx->nrefs++;
+    return NULL;
+  }
+  w = serialize_more(w, sbx, 1+5);
+  *w++ = SER_TAG_REF;
+  return serialize_wu124(w, tv->u32.lo);
+}
+
 /* Put serialized object into buffer. */
 static char *serialize_put(char *w, SBufExt *sbx, cTValue *o)
 {
@@ -189,6 +377,10 @@ static char *serialize_put(char *w, SBufExt *sbx, cTValue *o)
   } else if (tvistab(o)) {
     const GCtab *t = tabV(o);
     uint32_t narray = 0, nhash = 0, one = 2;
+    if ((sbx->sopt & LJ_SERIALIZE_REF)) {
+      char *wr = serialize_put_ref(w, sbx, (GCtab *)t);
+      if (wr) return wr;
+    }
     if (sbx->depth <= 0) lj_err_caller(sbufL(sbx), LJ_ERR_BUFFER_DEPTH);
     sbx->depth--;
     if (t->asize > 0) {  /* Determine max. length of array part. */
@@ -222,6 +414,13 @@ static char *serialize_put(char *w, SBufExt *sbx, cTValue *o)
 	}
       } while ((n = nextnode(n)));
     }
+    if ((sbx->sopt & LJ_SERIALIZE_SHAPE) && nhash && !narray) {
+      char *ws = serialize_put_shape(w, sbx, t, nhash);
+      if (ws) {
+	sbx->depth++;
+	return ws;
+      }
+    }
     /* Write number of array slots and hash slots. */
     w = serialize_more(w, sbx, 1+2*5);
     *w++ = (char)(SER_TAG_TAB + (nhash ? 1 : 0) + (narray ? one : 0));
@@ -235,30 +434,11 @@ static char *serialize_put(char *w, SBufExt *sbx, cTValue *o)
     if (nhash) {  /* Write hash entries. */
       const Node *node = noderef(t->node) + t->hmask;
       GCtab *dict_str = tabref(sbx->dict_str);
-      if (LJ_UNLIKELY(dict_str)) {
+      if (LJ_UNLIKELY(dict_str || sbx->adictsz)) {
 	for (;; node--)
 	  if (!tvisnil(&node->val)) {
 	    if (LJ_LIKELY(tvisstr(&node->key))) {
-	      /* Inlined lj_tab_getstr is 30% faster. */
-	      const GCstr *str = strV(&node->key);
-	      Node *n = hashstr(dict_str, str);
-	      do {
-		if (tvisstr(&n->key) && strV(&n->key) == str) {
-		  uint32_t idx = n->val.u32.lo;
-		  w = serialize_more(w, sbx, 1+5);
-		  *w++ = SER_TAG_DICT_STR;
-		  w = serialize_wu124(w, idx);
-		  break;
-		}
-		n = nextnode(n);
-		if (!n) {
-		  MSize len = str->len;
-		  w = serialize_more(w, sbx, 5+len);
-		  w = serialize_wu124(w, SER_TAG_STR + len);
-		  w = lj_buf_wmem(w, strdata(str), len);
-		  break;
-		}
-	      } while (1);
+	      w = serialize_putkey(w, sbx, dict_str, strV(&node->key));
 	    } else {
 	      w = serialize_put(w, sbx, &node->key);
 	    }
@@ -335,6 +515,78 @@ static char *serialize_put(char *w, SBufExt *sbx, cTValue *o)
   return w;
 }
 
+static char *serialize_get(char *r, SBufExt *sbx, TValue *o);
+
+/* Get shape definition or reference from buffer.
+** Returns the template table and the hash slots of the keys in value order.
+*/
+static char *serialize_get_shape(char *r, SBufExt *sbx, uint32_t tp,
+				 GCtab **tplp, GCstr **slotp)
+{
+  lua_State *L = sbufL(sbx);
+  GCtab *st = tabref(sbx->shapes);
+  uint32_t n;
+  r = serialize_ru124(r, sbx->w, &n); if (LJ_UNLIKELY(!r)) goto eob;
+  if (tp == SER_TAG_SHAPE) {  /* Shape definition: n keys. */
+    uint32_t slot[SER_SHAPE_MAXKEY];
+    GCtab *tpl;
+    Node *node;
+    uint32_t i, id = sbx->nshapes;
+    if (n == 0 || n > SER_SHAPE_MAXKEY)
+      lj_err_callerv(L, LJ_ERR_BUFFER_BADDEC, tp);
+    tpl = lj_tab_new(L, 0, hsize2hbits(n));
+    if (!st) {
+      st = lj_tab_new(L, 16, 0);
+      setgcref(sbx->shapes, obj2gco(st));
+    }
+    setgcV(L, lj_tab_setint(L, st, (int32_t)(2*id+1)), obj2gco(tpl), LJ_TTAB);
+    for (i = 0; i < n; i++) {
+      TValue k, *v;
+      r = serialize_get(r, sbx, &k);
+      if (!tvisstr(&k)) lj_err_callerv(L, LJ_ERR_BUFFER_BADDEC, tp);
+      v = lj_tab_setstr(L, tpl, strV(&k));
+      if (LJ_UNLIKELY(!tvisnil(v)))
+	lj_err_caller(L, LJ_ERR_BUFFER_DUPKEY);
+      v->u64 = i;  /* Temporary value: position of the key. */
+    }
+    /* Key insertion may move nodes, so get the final slots afterwards. */
+    node = noderef(tpl->node);
+    for (i = 0; i <= tpl->hmask; i++)
+      if (!tvisnil(&node[i].val)) {
+	slot[node[i].val.u32.lo] = i;
+	setnilV(&node[i].val);
+      }
+    *slotp = lj_str_new(L, (const char *)slot, n*(MSize)sizeof(uint32_t));
+    setstrV(L, lj_tab_setint(L, st, (int32_t)(2*id+2)), *slotp);
+    *tplp = tpl;
+    sbx->nshapes++;
+  } else {  /* Shape reference: shape index. */
+    cTValue *tv = st && n < sbx->nshapes ?
+		  lj_tab_getint(st, (int32_t)(2*n+1)) : NULL;
+    if (!tv || !tvistab(tv))
+      lj_err_callerv(L, LJ_ERR_BUFFER_BADDICTX, n);
+    *tplp = tabV(tv);
+    *slotp = strV(lj_tab_getint(st, (int32_t)(2*n+2)));
+  }
+  return r;
+eob:
+  lj_err_caller(L, LJ_ERR_BUFFER_EOB);
+  return NULL;
+}
+
+/* Remember a decoded table for later references. */
+static void serialize_get_ref(SBufExt *sbx, GCtab *t)
+{
+  lua_State *L = sbufL(sbx);
+  GCtab *rt = tabref(sbx->refs);
+  int32_t idx = (int32_t)++sbx->nrefs;
+  if (!rt) {
+    rt = lj_tab_new(L, 0, 0);
+    setgcref(sbx->refs, obj2gco(rt));
+  }
+  settabV(L, lj_tab_setint(L, rt, idx), t);
+}
+
 /* Get serialized object from buffer. */
 static char *serialize_get(char *r, SBufExt *sbx, TValue *o)
 {
@@ -359,6 +611,18 @@ static char *serialize_get(char *r, SBufExt *sbx, TValue *o)
     if (!tvisnum(o)) setnanV(o);  /* Fix non-canonical NaNs. */
   } else if (tp <= SER_TAG_TRUE) {
     setpriV(o, ~tp);
+  } else if (tp == SER_TAG_REF) {
+    GCtab *rt = tabref(sbx->refs);
+    cTValue *tv = NULL;
+    uint32_t idx;
+    r = serialize_ru124(r, w, &idx); if (LJ_UNLIKELY(!r)) goto eob;
+    if (rt && idx < sbx->nrefs) {
+      int32_t k = (int32_t)idx+1;
+      tv = lj_tab_getint(rt, k);
+    }
+    if (!(tv && tvistab(tv)))
+      lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADREF, idx);
+    copyTV(sbufL(sbx), o, tv);
   } else if (tp == SER_TAG_DICT_STR) {
     GCtab *dict_str;
     uint32_t idx;
@@ -369,7 +633,31 @@ static char *serialize_get(char *r, SBufExt *sbx, TValue *o)
       copyTV(sbufL(sbx), o, arrayslot(dict_str, idx));
     else
       lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADDICTX, idx);
-  } else if (tp >= SER_TAG_TAB && tp <= SER_TAG_DICT_MT) {
+  } else if (tp == SER_TAG_ADICT_NEW || tp == SER_TAG_ADICT_REF) {
+    lua_State *L = sbufL(sbx);
+    GCtab *ad = tabref(sbx->adictd);
+    uint32_t idx;
+    int32_t k;
+    r = serialize_ru124(r, w, &idx); if (LJ_UNLIKELY(!r)) goto eob;
+    if (!ad || idx >= sbx->adictsz)
+      lj_err_callerv(L, LJ_ERR_BUFFER_BADDICTX, idx);
+    k = (int32_t)idx+1;
+    if (tp == SER_TAG_ADICT_NEW) {
+      uint32_t len;
+      r = serialize_ru124(r, w, &len); if (LJ_UNLIKELY(!r)) goto eob;
+      if (LJ_UNLIKELY(len > (uint32_t)(w - r))) goto eob;
+      setstrV(L, o, lj_str_new(L, r, len));
+      r += len;
+      lj_gc_anybarriert(L, ad);
+      copyTV(L, lj_tab_setint(L, ad, k), o);
+    } else {
+      cTValue *tv = lj_tab_getint(ad, k);
+      if (!(tv && tvisstr(tv)))
+	lj_err_callerv(L, LJ_ERR_BUFFER_BADDICTX, idx);
+      copyTV(L, o, tv);
+    }
+  } else if ((tp >= SER_TAG_TAB && tp <= SER_TAG_DICT_MT) ||
+	     tp == SER_TAG_SHAPE || tp == SER_TAG_SHAPE_REF) {
     uint32_t narray = 0, nhash = 0;
     GCtab *t, *mt = NULL;
     if (sbx->depth <= 0) lj_err_caller(sbufL(sbx), LJ_ERR_BUFFER_DEPTH);
@@ -385,7 +673,27 @@ static char *serialize_get(char *r, SBufExt *sbx, TValue *o)
       else
 	lj_err_callerv(sbufL(sbx), LJ_ERR_BUFFER_BADDICTX, idx);
       r = serialize_ru124(r, w, &tp); if (LJ_UNLIKELY(!r)) goto eob;
-      if (!(tp >= SER_TAG_TAB && tp < SER_TAG_DICT_MT)) goto badtag;
+      if (!((tp >= SER_TAG_TAB && tp < SER_TAG_DICT_MT) ||
+	    tp == SER_TAG_SHAPE || tp == SER_TAG_SHAPE_REF)) goto badtag;
+    }
+    if (tp >= SER_TAG_SHAPE) {  /* Table by shape. Copy the template. */
+      GCstr *slots;
+      const uint32_t *slot;
+      Node *node;
+      r = serialize_get_shape(r, sbx, tp, &t, &slots);
+      t = lj_tab_dup(sbufL(sbx), t);
+      /* NOBARRIER: The table is new (marked white). */
+      setgcref(t->metatable, obj2gco(mt));
+      settabV(sbufL(sbx), o, t);
+      if ((sbx->sopt & LJ_SERIALIZE_REF)) serialize_get_ref(sbx, t);
+      node = noderef(t->node);
+      slot = (const uint32_t *)strdata(slots);
+      nhash = slots->len / sizeof(uint32_t);
+      do {
+	r = serialize_get(r, sbx, &node[*slot++].val);
+      } while (--nhash);
+      sbx->depth++;
+      return r;
     }
     if (tp >= SER_TAG_TAB+2) {
       r = serialize_ru124(r, w, &narray); if (LJ_UNLIKELY(!r)) goto eob;
@@ -397,6 +705,7 @@ static char *serialize_get(char *r, SBufExt *sbx, TValue *o)
     /* NOBARRIER: The table is new (marked white). */
     setgcref(t->metatable, obj2gco(mt));
     settabV(sbufL(sbx), o, t);
+    if ((sbx->sopt & LJ_SERIALIZE_REF)) serialize_get_ref(sbx, t);
     if (narray) {
       TValue *oa = tvref(t->array) + (tp >= SER_TAG_TAB+4);
       TValue *oe = tvref(t->array) + narray;
@@ -467,19 +776,161 @@ eob:
 
 /* -- External serialization API ------------------------------------------ */
 
+/* Shapes and references are only valid within a single top-level object. */
+static LJ_AINLINE void serialize_state_reset(SBufExt *sbx)
+{
+  setgcrefnull(sbx->shapes);
+  sbx->nshapes = sbx->lastshape = 0;
+  setgcrefnull(sbx->refs);
+  sbx->nrefs = 0;
+}
+
 /* Encode to buffer. */
 SBufExt * LJ_FASTCALL lj_serialize_put(SBufExt *sbx, cTValue *o)
 {
   sbx->depth = LJ_SERIALIZE_DEPTH;
+  serialize_state_reset(sbx);
+  if (LJ_UNLIKELY(sbx->adictnew)) serialize_adict_undo(sbx);
+  sbx->adictmark = sbx->adictnext;
   sbx->w = serialize_put(sbx->w, sbx, o);
+  sbx->adictnew = 0;
+  serialize_state_reset(sbx);
   return sbx;
 }
 
 /* Decode from buffer. */
 char * LJ_FASTCALL lj_serialize_get(SBufExt *sbx, TValue *o)
 {
+  char *r;
   sbx->depth = LJ_SERIALIZE_DEPTH;
-  return serialize_get(sbx->r, sbx, o);
+  serialize_state_reset(sbx);
+  r = serialize_get(sbx->r, sbx, o);
+  serialize_state_reset(sbx);
+  return r;
+}
+
+/* Check whether the buffer holds a complete object, without decoding it.
+** Malformed data counts as complete, so the decoder throws the error.
+*/
+int LJ_FASTCALL lj_serialize_complete(SBufExt *sbx)
+{
+  SBuf *sb = lj_buf_tmp_(sbufL(sbx));  /* Number of values per shape. */
+  char *r = sbx->r, *w = sbx->w;
+  uint64_t need = 1;
+  do {
+    uint32_t tp, n = 0;
+    r = serialize_ru124(r, w, &tp); if (!r) return 0;
+    if (tp >= SER_TAG_STR) {
+      n = tp - SER_TAG_STR;
+    } else if (tp == SER_TAG_INT || tp == SER_TAG_LIGHTUD32) {
+      n = 4;
+    } else if (tp == SER_TAG_NUM || tp == SER_TAG_LIGHTUD64 ||
+	       tp == SER_TAG_INT64 || tp == SER_TAG_UINT64) {
+      n = 8;
+    } else if (tp == SER_TAG_COMPLEX) {
+      n = 16;
+    } else if (tp == SER_TAG_DICT_STR || tp == SER_TAG_DICT_MT ||
+	       tp == SER_TAG_REF || tp == SER_TAG_ADICT_REF) {
+      uint32_t idx;
+      r = serialize_ru124(r, w, &idx); if (!r) return 0;
+      if (tp == SER_TAG_DICT_MT) need++;  /* Followed by the table. */
+    } else if (tp == SER_TAG_ADICT_NEW) {
+      uint32_t idx;
+      r = serialize_ru124(r, w, &idx); if (!r) return 0;
+      r = serialize_ru124(r, w, &n); if (!r) return 0;
+    } else if (tp >= SER_TAG_TAB && tp < SER_TAG_DICT_MT) {
+      uint32_t narray = 0, nhash = 0, one = (tp >= SER_TAG_TAB+4);
+      if (tp >= SER_TAG_TAB+2) {
+	r = serialize_ru124(r, w, &narray); if (!r) return 0;
+      }
+      if ((tp & 1)) {
+	r = serialize_ru124(r, w, &nhash); if (!r) return 0;
+      }
+      if (narray > one) need += narray - one;
+      need += 2*(uint64_t)nhash;
+    } else if (tp == SER_TAG_SHAPE) {
+      uint32_t nkey;
+      r = serialize_ru124(r, w, &nkey); if (!r) return 0;
+      need += 2*(uint64_t)nkey;
+      *(uint32_t *)lj_buf_more(sb, 4) = nkey;
+      sb->w += 4;
+    } else if (tp == SER_TAG_SHAPE_REF) {
+      uint32_t id;
+      r = serialize_ru124(r, w, &id); if (!r) return 0;
+      if (id >= sbuflen(sb) >> 2) return 1;
+      need += ((uint32_t *)sb->b)[id];
+    } else if (tp > SER_TAG_NULL) {
+      return 1;
+    }
+    if ((MSize)(w - r) < n) return 0;
+    r += n;
+  } while (--need);
+  return 1;
+}
+
+typedef struct SerFrame {
+  SBufExt *sbx;		/* Buffer to encode to. */
+  cTValue *o;		/* Object to encode. */
+} SerFrame;
+
+static TValue *cpputframe(lua_State *L, lua_CFunction dummy, void *ud)
+{
+  SerFrame *sf = (SerFrame *)ud;
+  UNUSED(L); UNUSED(dummy);
+  lj_serialize_put(sf->sbx, sf->o);
+  return NULL;
+}
+
+/* Encode to buffer, prefixed with the 32 bit little-endian length. */
+SBufExt * LJ_FASTCALL lj_serialize_putframe(SBufExt *sbx, cTValue *o)
+{
+  char *w = lj_buf_more((SBuf *)sbx, 4);
+  MSize ofs = (MSize)(w - sbx->r);  /* Compaction only moves sbx->r. */
+  uint32_t len;
+  SerFrame sf;
+  int errcode;
+  sbx->w = w + 4;
+  sf.sbx = sbx;
+  sf.o = o;
+  errcode = lj_vm_cpcall(sbufL(sbx), NULL, &sf, cpputframe);
+  w = sbx->r + ofs;
+  if (errcode) {  /* Drop the partial frame, so the stream stays parseable. */
+    sbx->w = w;
+    lj_err_throw(sbufL(sbx), errcode);
+  }
+  len = (uint32_t)(sbx->w - w - 4);
+#if LJ_BE
+  len = lj_bswap(len);
+#endif
+  memcpy(w, &len, 4);
+  return sbx;
+}
+
+/* Decode length-prefixed object from buffer. Returns NULL if incomplete. */
+char * LJ_FASTCALL lj_serialize_getframe(SBufExt *sbx, TValue *o)
+{
+  lua_State *L = sbufL(sbx);
+  SBufExt sbf;
+  char *r = sbx->r;
+  uint32_t len;
+  if (sbufxlen(sbx) < 4) return NULL;
+  len = lj_getu32(r);
+#if LJ_BE
+  len = lj_bswap(len);
+#endif
+  if (sbufxlen(sbx) - 4 < len) return NULL;
+  /* Decode in place from a copy-on-write view of the frame. */
+  memset(&sbf, 0, sizeof(SBufExt));
+  lj_bufx_set_cow(L, &sbf, r + 4, len);
+  setgcrefr(sbf.dict_str, sbx->dict_str);
+  setgcrefr(sbf.dict_mt, sbx->dict_mt);
+  setgcrefr(sbf.adictd, sbx->adictd);
+  sbf.adictsz = sbx->adictsz;
+  sbf.sopt = sbx->sopt;
+  sbf.depth = LJ_SERIALIZE_DEPTH;
+  r = serialize_get(sbf.r, &sbf, o);
+  if (r != sbf.w) lj_err_caller(L, LJ_ERR_BUFFER_LEFTOV);
+  return r;
 }
 
 /* Stand-alone encoding, borrowing from global temporary buffer. */
@@ -524,7 +975,8 @@ LJ_FUNC MSize LJ_FASTCALL lj_serialize_peektype(SBufExt *sbx)
     case SER_TAG_NUM: return IRT_NUM;
     case SER_TAG_TAB: case SER_TAG_TAB+1: case SER_TAG_TAB+2:
     case SER_TAG_TAB+3: case SER_TAG_TAB+4: case SER_TAG_TAB+5:
-    case SER_TAG_DICT_MT:
+    case SER_TAG_DICT_MT: case SER_TAG_SHAPE: case SER_TAG_SHAPE_REF:
+    case SER_TAG_REF:
       return IRT_TAB;
     case SER_TAG_INT64: case SER_TAG_UINT64: case SER_TAG_COMPLEX:
       return IRT_CDATA;
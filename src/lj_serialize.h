@@ -13,10 +13,21 @@
 
 #define LJ_SERIALIZE_DEPTH	100	/* Default depth. */
 
+/* Serialization options. */
+#define LJ_SERIALIZE_SHAPE	0x01	/* Encode tables by shape. */
+#define LJ_SERIALIZE_REF	0x02	/* Encode repeated tables by reference. */
+
+#define LJ_SERIALIZE_ADICTSZ	256	/* Default size of adaptive dictionary. */
+#define LJ_SERIALIZE_ADICTMAX	65536	/* Max. size of adaptive dictionary. */
+
 LJ_FUNC void LJ_FASTCALL lj_serialize_dict_prep_str(lua_State *L, GCtab *dict);
 LJ_FUNC void LJ_FASTCALL lj_serialize_dict_prep_mt(lua_State *L, GCtab *dict);
+LJ_FUNC void lj_serialize_adict_init(lua_State *L, SBufExt *sbx, uint32_t sz);
 LJ_FUNC SBufExt * LJ_FASTCALL lj_serialize_put(SBufExt *sbx, cTValue *o);
 LJ_FUNC char * LJ_FASTCALL lj_serialize_get(SBufExt *sbx, TValue *o);
+LJ_FUNC int LJ_FASTCALL lj_serialize_complete(SBufExt *sbx);
+LJ_FUNC SBufExt * LJ_FASTCALL lj_serialize_putframe(SBufExt *sbx, cTValue *o);
+LJ_FUNC char * LJ_FASTCALL lj_serialize_getframe(SBufExt *sbx, TValue *o);
 LJ_FUNC GCstr * LJ_FASTCALL lj_serialize_encode(lua_State *L, cTValue *o);
 LJ_FUNC void lj_serialize_decode(lua_State *L, TValue *o, GCstr *str);
 #if LJ_HASJIT
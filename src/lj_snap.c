@@ -327,6 +327,10 @@ static void snap_useuv(GCproto *pt, uint8_t *udf)
     for (i = 0; i < n; i++, kr--) {
       GCobj *o = gcref(*kr);
       if (o->gch.gct == ~LJ_TPROTO) {
+	if (proto_islazy(gco2pt(o))) {  /* Upvalues unknown, keep all slots. */
+	  memset(udf, 0, SNAP_USEDEF_SLOTS);
+	  return;
+	}
 	for (j = 0; j < gco2pt(o)->sizeuv; j++) {
 	  uint32_t v = proto_uv(gco2pt(o))[j];
 	  if ((v & PROTO_UV_LOCAL)) {
@@ -175,6 +175,7 @@ static void close_state(lua_State *L)
 #endif
   lj_str_freetab(g);
   lj_buf_free(g, &g->tmpbuf);
+  lj_buf_pool_free(g);
   lj_mem_freevec(g, tvref(L->stack), L->stacksize, TValue);
 #if LJ_64
   if (mref(g->gc.lightudseg, uint32_t)) {
@@ -247,6 +248,7 @@ LUA_API lua_State *lua_newstate(lua_Alloc allocf, void *allocd)
   setmref(g->nilnode.freetop, &g->nilnode);
 #endif
   lj_buf_init(NULL, &g->tmpbuf);
+  g->bufpool.limit = LJ_POOLSBUF_MEM;
   g->gc.state = GCSpause;
   setgcref(g->gc.root, obj2gco(L));
   setmref(g->gc.sweep, &g->gc.root);
@@ -78,42 +78,53 @@ static LJ_AINLINE void clearapart(GCtab *t)
     setnilV(&array[i]);
 }
 
+/* Check whether the array or hash part is still colocated. */
+#define colo_isarray(t)	(colo_asize(t) && (t)->colo >= 0)
+#define colo_ishash(t)	(colo_hbits(t) && noderef((t)->node) == colo_node(t))
+
+/* Use colocated hash part of table. */
+static void colohpart(GCtab *t, uint32_t hbits)
+{
+  uint32_t hsize = 1u << hbits;
+  Node *node = colo_node(t);
+  lj_assertX(hbits != 0 && hbits <= colo_hbits(t), "bad colocated hash size");
+  setmref(t->node, node);
+  setfreetop(t, node, &node[hsize]);
+  t->hmask = hsize-1;
+}
+
 /* Create a new table. Note: the slots are not initialized (yet). */
 static GCtab *newtab(lua_State *L, uint32_t asize, uint32_t hbits)
 {
   GCtab *t;
-  /* First try to colocate the array part. */
-  if (LJ_MAX_COLOSIZE != 0 && asize > 0 && asize <= LJ_MAX_COLOSIZE) {
-    Node *nilnode;
+  Node *nilnode;
+  /* First try to colocate the array and/or the hash part. */
+  uint32_t acolo = asize <= LJ_MAX_COLOSIZE ? asize : 0;
+  uint32_t hcolo = hbits <= LJ_MAX_COLOHBITS ? hbits : 0;
+  if (acolo | hcolo) {
     lj_assertL((sizeof(GCtab) & 7) == 0, "bad GCtab size");
-    t = (GCtab *)lj_mem_newgco(L, sizetabcolo(asize));
-    t->gct = ~LJ_TTAB;
-    t->nomm = (uint8_t)~0;
-    t->colo = (int8_t)asize;
-    setmref(t->array, (TValue *)((char *)t + sizeof(GCtab)));
-    setgcrefnull(t->metatable);
-    t->asize = asize;
-    t->hmask = 0;
-    nilnode = &G(L)->nilnode;
-    setmref(t->node, nilnode);
+    t = (GCtab *)lj_mem_newgco(L, sizetabcolo(acolo) + sizetabcoloh(hcolo));
+    t->colo = (int8_t)(acolo | (hcolo << LJ_COLO_HSHIFT));
+  } else {
+    t = lj_mem_newobj(L, GCtab);
+    t->colo = 0;
+  }
+  t->gct = ~LJ_TTAB;
+  t->nomm = (uint8_t)~0;
+  setgcrefnull(t->metatable);
+  t->hmask = 0;
+  t->lenhint = 0;
+  nilnode = &G(L)->nilnode;
+  setmref(t->node, nilnode);
 #if LJ_GC64
-    setmref(t->freetop, nilnode);
+  setmref(t->freetop, nilnode);
 #endif
+  if (acolo) {
+    setmref(t->array, (TValue *)((char *)t + sizeof(GCtab)));
+    t->asize = asize;
   } else {  /* Otherwise separately allocate the array part. */
-    Node *nilnode;
-    t = lj_mem_newobj(L, GCtab);
-    t->gct = ~LJ_TTAB;
-    t->nomm = (uint8_t)~0;
-    t->colo = 0;
     setmref(t->array, NULL);
-    setgcrefnull(t->metatable);
     t->asize = 0;  /* In case the array allocation fails. */
-    t->hmask = 0;
-    nilnode = &G(L)->nilnode;
-    setmref(t->node, nilnode);
-#if LJ_GC64
-    setmref(t->freetop, nilnode);
-#endif
     if (asize > 0) {
       if (asize > LJ_MAX_ASIZE)
 	lj_err_msg(L, LJ_ERR_TABOV);
@@ -121,7 +132,9 @@ static GCtab *newtab(lua_State *L, uint32_t asize, uint32_t hbits)
       t->asize = asize;
     }
   }
-  if (hbits)
+  if (hcolo)
+    colohpart(t, hcolo);
+  else if (hbits)
     newhpart(L, t, hbits);
   return t;
 }
@@ -161,11 +174,28 @@ GCtab * LJ_FASTCALL lj_tab_new1(lua_State *L, uint32_t ahsize)
 }
 #endif
 
-/* Duplicate a table. */
+/* Replace nested template tables with copies. */
+static LJ_NOINLINE void tab_dup_nested(lua_State *L, GCtab *t)
+{
+  uint32_t i, asize = t->asize, hmask = t->hmask;
+  TValue *array = tvref(t->array);
+  Node *node = noderef(t->node);
+  for (i = 0; i < asize; i++)
+    if (tvistab(&array[i]))
+      settabV(L, &array[i], lj_tab_dup(L, tabV(&array[i])));
+  if (hmask > 0) {
+    for (i = 0; i <= hmask; i++)
+      if (tvistab(&node[i].val))
+	settabV(L, &node[i].val, lj_tab_dup(L, tabV(&node[i].val)));
+  }
+}
+
+/* Duplicate a (possibly nested) template table. */
 GCtab * LJ_FASTCALL lj_tab_dup(lua_State *L, const GCtab *kt)
 {
   GCtab *t;
   uint32_t asize, hmask;
+  int nested = 0;
   t = newtab(L, kt->asize, kt->hmask > 0 ? lj_fls(kt->hmask)+1 : 0);
   lj_assertL(kt->asize == t->asize && kt->hmask == t->hmask,
 	     "mismatched size of table and template");
@@ -176,10 +206,15 @@ GCtab * LJ_FASTCALL lj_tab_dup(lua_State *L, const GCtab *kt)
     TValue *karray = tvref(kt->array);
     if (asize < 64) {  /* An inlined loop beats memcpy for < 512 bytes. */
       uint32_t i;
-      for (i = 0; i < asize; i++)
+      for (i = 0; i < asize; i++) {
 	copyTV(L, &array[i], &karray[i]);
+	nested |= tvistab(&karray[i]);
+      }
     } else {
+      uint32_t i;
       memcpy(array, karray, asize*sizeof(TValue));
+      for (i = 0; i < asize; i++)
+	nested |= tvistab(&karray[i]);
     }
   }
   hmask = kt->hmask;
@@ -196,8 +231,11 @@ GCtab * LJ_FASTCALL lj_tab_dup(lua_State *L, const GCtab *kt)
       /* Don't use copyTV here, since it asserts on a copy of a dead key. */
       n->val = kn->val; n->key = kn->key;
       setmref(n->next, next == NULL? next : (Node *)((char *)next + d));
+      nested |= tvistab(&kn->val);
     }
   }
+  if (LJ_UNLIKELY(nested))  /* Template tables only hold nested templates. */
+    tab_dup_nested(L, t);
   return t;
 }
 
@@ -215,12 +253,13 @@ void LJ_FASTCALL lj_tab_clear(GCtab *t)
 /* Free a table. */
 void LJ_FASTCALL lj_tab_free(global_State *g, GCtab *t)
 {
-  if (t->hmask > 0)
+  if (t->hmask > 0 && !colo_ishash(t))
     lj_mem_freevec(g, noderef(t->node), t->hmask+1, Node);
-  if (t->asize > 0 && LJ_MAX_COLOSIZE != 0 && t->colo <= 0)
+  if (t->asize > 0 && !colo_isarray(t))
     lj_mem_freevec(g, tvref(t->array), t->asize, TValue);
-  if (LJ_MAX_COLOSIZE != 0 && t->colo)
-    lj_mem_free(g, t, sizetabcolo((uint32_t)t->colo & 0x7f));
+  if (t->colo)
+    lj_mem_free(g, t, sizetabcolo(colo_asize(t)) +
+		      sizetabcoloh(colo_hbits(t)));
   else
     lj_mem_freet(g, t);
 }
@@ -233,16 +272,18 @@ void lj_tab_resize(lua_State *L, GCtab *t, uint32_t asize, uint32_t hbits)
   Node *oldnode = noderef(t->node);
   uint32_t oldasize = t->asize;
   uint32_t oldhmask = t->hmask;
+  int oldcolo = oldhmask > 0 && colo_ishash(t);
+  Node tmpnode[1u << LJ_MAX_COLOHBITS];
   if (asize > oldasize) {  /* Array part grows? */
     TValue *array;
     uint32_t i;
     if (asize > LJ_MAX_ASIZE)
       lj_err_msg(L, LJ_ERR_TABOV);
-    if (LJ_MAX_COLOSIZE != 0 && t->colo > 0) {
+    if (colo_isarray(t)) {
       /* A colocated array must be separated and copied. */
       TValue *oarray = tvref(t->array);
       array = lj_mem_newvec(L, asize, TValue);
-      t->colo = (int8_t)(t->colo | 0x80);  /* Mark as separated (colo < 0). */
+      t->colo = (int8_t)(t->colo | LJ_COLO_ASEP);  /* Mark as separated. */
       for (i = 0; i < oldasize; i++)
 	copyTV(L, &array[i], &oarray[i]);
     } else {
@@ -256,7 +297,15 @@ void lj_tab_resize(lua_State *L, GCtab *t, uint32_t asize, uint32_t hbits)
   }
   /* Create new (empty) hash part. */
   if (hbits) {
-    newhpart(L, t, hbits);
+    if (hbits <= colo_hbits(t)) {  /* Fits into the colocated hash part? */
+      if (oldcolo) {  /* Move old pairs out of the way, first. */
+	memcpy(tmpnode, oldnode, (oldhmask+1)*sizeof(Node));
+	oldnode = tmpnode;
+      }
+      colohpart(t, hbits);
+    } else {
+      newhpart(L, t, hbits);
+    }
     clearhpart(t);
   } else {
     global_State *g = G(L);
@@ -274,7 +323,7 @@ void lj_tab_resize(lua_State *L, GCtab *t, uint32_t asize, uint32_t hbits)
       if (!tvisnil(&array[i]))
 	copyTV(L, lj_tab_setinth(L, t, (int32_t)i), &array[i]);
     /* Physically shrink only separated arrays. */
-    if (LJ_MAX_COLOSIZE != 0 && t->colo <= 0)
+    if (!colo_isarray(t))
       setmref(t->array, lj_mem_realloc(L, array,
 	      oldasize*sizeof(TValue), asize*sizeof(TValue)));
   }
@@ -286,8 +335,10 @@ void lj_tab_resize(lua_State *L, GCtab *t, uint32_t asize, uint32_t hbits)
       if (!tvisnil(&n->val))
 	copyTV(L, lj_tab_set(L, t, &n->key), &n->val);
     }
-    g = G(L);
-    lj_mem_freevec(g, oldnode, oldhmask+1, Node);
+    if (!oldcolo) {
+      g = G(L);
+      lj_mem_freevec(g, oldnode, oldhmask+1, Node);
+    }
   }
 }
 
@@ -567,6 +618,40 @@ TValue *lj_tab_set(lua_State *L, GCtab *t, cTValue *key)
   return lj_tab_newkey(L, t, key);
 }
 
+/* Move a1[f..e] to a2[t..t+e-f]. Like table.move(), but no metamethods. */
+void lj_tab_move(lua_State *L, GCtab *a1, int32_t f, int32_t e, int32_t t,
+		 GCtab *a2)
+{
+  int64_t n = (int64_t)e - f;
+  if (n < 0) return;
+  if (f >= 0 && (uint32_t)e < a1->asize &&
+      t >= 0 && (uint64_t)t + (uint64_t)n < a2->asize) {
+    /* Both ranges are inside the array parts: move them in one go. */
+    memmove(arrayslot(a2, t), arrayslot(a1, f), (size_t)(n+1)*sizeof(TValue));
+  } else {
+    lua_Number d = (lua_Number)t - (lua_Number)f;
+    int64_t i = f, iend = e, step = 1;
+    if (a1 == a2 && t > f && t <= e) {  /* Overlap: move backwards. */
+      i = e; iend = f; step = -1;
+    }
+    for (;; i += step) {
+      cTValue *src = lj_tab_getint(a1, (int32_t)i);
+      TValue k;
+      setnumV(&k, (lua_Number)i + d);
+      if (src && !tvisnil(src)) {
+	TValue *dst = lj_tab_set(L, a2, &k);
+	/* The set may invalidate the get pointer, so need to get it again. */
+	copyTV(L, dst, lj_tab_getint(a1, (int32_t)i));
+      } else {
+	cTValue *dst = lj_tab_get(L, a2, &k);
+	if (!tvisnil(dst)) setnilV((TValue *)dst);
+      }
+      if (i == iend) break;
+    }
+  }
+  if (a1 != a2) lj_gc_anybarriert(L, a2);
+}
+
 /* -- Table traversal ----------------------------------------------------- */
 
 /* Table traversal indexes:
@@ -658,8 +743,8 @@ LJ_NOINLINE static MSize tab_len_slow(GCtab *t, size_t hi)
   return (MSize)lo;
 }
 
-/* Compute table length. Fast path. */
-MSize LJ_FASTCALL lj_tab_len(GCtab *t)
+/* Compute table length. Search the array part. */
+static MSize tab_len_search(GCtab *t)
 {
   size_t hi = (size_t)t->asize;
   if (hi) hi--;
@@ -677,6 +762,35 @@ MSize LJ_FASTCALL lj_tab_len(GCtab *t)
   return t->hmask ? tab_len_slow(t, hi) : (MSize)hi;
 }
 
+/* Check whether n is a border, i.e. t[n] ~= nil (or n == 0), t[n+1] == nil. */
+static LJ_AINLINE int tab_isborder(GCtab *t, MSize n)
+{
+  cTValue *tv;
+  if (n >= (MSize)LJ_MAX_ASIZE) return 0;
+  if (n > 0 && ((tv = lj_tab_getint(t, (int32_t)n)) == NULL || tvisnil(tv)))
+    return 0;
+  tv = lj_tab_getint(t, (int32_t)(n+1));
+  return tv == NULL || tvisnil(tv);
+}
+
+/* Compute table length. Fast path.
+**
+** The last result is cached in the table. It's verified before use, so
+** stores don't need to update it. Appending or removing a single element
+** at the end only needs to check the neighbouring borders.
+*/
+MSize LJ_FASTCALL lj_tab_len(GCtab *t)
+{
+  MSize n = t->lenhint;
+  if (LJ_LIKELY(tab_isborder(t, n+1))) n++;  /* Append. */
+  else if (!tab_isborder(t, n)) {
+    if (n > 0 && tab_isborder(t, n-1)) n--;  /* Remove. */
+    else n = tab_len_search(t);
+  }
+  t->lenhint = n;
+  return n;
+}
+
 #if LJ_HASJIT
 /* Verify hinted table length or compute it. */
 MSize LJ_FASTCALL lj_tab_len_hint(GCtab *t, size_t hint)
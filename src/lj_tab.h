@@ -78,6 +78,8 @@ LJ_FUNCA TValue *lj_tab_newkey(lua_State *L, GCtab *t, cTValue *key);
 LJ_FUNCA TValue *lj_tab_setinth(lua_State *L, GCtab *t, int32_t key);
 LJ_FUNC TValue *lj_tab_setstr(lua_State *L, GCtab *t, const GCstr *key);
 LJ_FUNC TValue *lj_tab_set(lua_State *L, GCtab *t, cTValue *key);
+LJ_FUNC void lj_tab_move(lua_State *L, GCtab *a1, int32_t f, int32_t e,
+			 int32_t t, GCtab *a2);
 
 #define inarray(t, key)		((MSize)(key) < (MSize)(t)->asize)
 #define arrayslot(t, i)		(&tvref((t)->array)[(i)])
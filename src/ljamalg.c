@@ -40,6 +40,10 @@
 #include "lj_strfmt.c"
 #include "lj_strfmt_num.c"
 #include "lj_serialize.c"
+#include "lj_compress.c"
+#include "lj_json.c"
+#include "lj_chan.c"
+#include "lj_io.c"
 #include "lj_api.c"
 #include "lj_profile.c"
 #include "lj_lex.c"
@@ -47,6 +51,7 @@
 #include "lj_bcread.c"
 #include "lj_bcwrite.c"
 #include "lj_load.c"
+#include "lj_image.c"
 #include "lj_ctype.c"
 #include "lj_cdata.c"
 #include "lj_cconv.c"
@@ -87,5 +92,6 @@
 #include "lib_jit.c"
 #include "lib_ffi.c"
 #include "lib_buffer.c"
+#include "lib_event.c"
 #include "lib_init.c"
 
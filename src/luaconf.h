@@ -66,6 +66,7 @@
 /* Environment variable names for path overrides and initialization code. */
 #define LUA_PATH	"LUA_PATH"
 #define LUA_CPATH	"LUA_CPATH"
+#define LUA_BCCACHE	"LUA_BCCACHE"
 #define LUA_INIT	"LUA_INIT"
 
 /* Special file system characters. */
@@ -64,6 +64,9 @@ enum {
 /* Control the JIT engine. */
 LUA_API int luaJIT_setmode(lua_State *L, int idx, int mode);
 
+/* Freeze a table and all tables reachable from it. */
+LUA_API void luaJIT_freeze(lua_State *L, int idx);
+
 /* Low-overhead profiling API. */
 typedef void (*luaJIT_profile_callback)(void *data, lua_State *L,
 					int samples, int vmstate);